@@ -0,0 +1,140 @@
+// 各种树状数组与朴素前缀和的对拍, 以及大规模随机 add/sum 的耗时
+// g++ -std=c++23 -O2 -march=native -pthread bench/BIT.cpp -o BIT && ./BIT [n] [ops] [threads]
+// blocked_BIT 的块内更新靠向量指令, 不加 -march 时只有 SSE2
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "../lib/data_structure/range_sum_container/binary_indexed_tree.h"
+#include "../lib/data_structure/range_sum_container/blocked_BIT.h"
+#include "../lib/data_structure/range_sum_container/concurrent_BIT.h"
+
+using ll = long long;
+
+// ops 中 first 为下标, second 为 0 时求前缀和, 否则加上 second
+template<typename BIT, typename T>
+ll run_ops(BIT &bit, const std::vector<std::pair<size_t, T> > &ops) {
+    ll acc = 0;
+    for (const auto &[idx, delta]: ops) {
+        if (delta)
+            bit.add(idx, delta);
+        else
+            acc ^= bit.sum(idx);
+    }
+    return acc;
+}
+
+// 一半 add 一半 sum; 随机下标, 或按顺序从 0 扫到 n - 1
+// 各结构轮流跑 rounds 轮取最短耗时, 减小机器噪声的影响
+template<typename T>
+void bench_ops(const size_t n, const size_t m, const bool sequential, std::mt19937_64 &rng) {
+    constexpr size_t rounds = 5;
+    std::vector<std::pair<size_t, T> > ops(m);
+    for (size_t i = 0; i < m; ++i) {
+        ops[i].first = sequential ? i * n / m : rng() % n;
+        ops[i].second = rng() % 2 ? static_cast<T>(rng() % 1000 + 1) : T{};
+    }
+    binary_indexed_tree<T> plain(n);
+    blocked_BIT<T> blocked(n);
+    double best[2]{1e18, 1e18};
+    ll res[2]{};
+    for (size_t r = 0; r < rounds; ++r) {
+        best[0] = std::min(best[0], time_ms([&] { res[0] ^= run_ops(plain, ops); }));
+        best[1] = std::min(best[1], time_ms([&] { res[1] ^= run_ops(blocked, ops); }));
+    }
+    check(res[0] == res[1], "large ops agree");
+    std::printf("%-10s %zu-byte  binary_indexed_tree %8.1f ms  blocked_BIT<%zu> %8.1f ms\n",
+                sequential ? "sequential" : "random", sizeof(T), best[0], 64 / sizeof(T), best[1]);
+}
+
+int main(const int argc, const char *argv[]) {
+    const size_t n = argc > 1 ? std::stoull(argv[1]) : 1uz << 24;
+    const size_t m = argc > 2 ? std::stoull(argv[2]) : 1uz << 23;
+    const size_t threads = argc > 3 ? std::stoull(argv[3]) : default_thread_count();
+    std::mt19937_64 rng(31);
+
+    // k 跨过 blocked_BIT 的多层边界 (B = 16 时 16, 256; B = 5 时 5, 25, 125; B = 2 时每个 2 的幂)
+    for (size_t k = 1; k <= 300; k += k < 70 ? 1 : 37) {
+        std::vector<ll> a(k);
+        std::vector<int> a32(k);
+        for (size_t i = 0; i < k; ++i)
+            a32[i] = static_cast<int>(a[i] = static_cast<ll>(rng() % 100));
+        binary_indexed_tree<ll> plain(a, from_origin_tag);
+        blocked_BIT<ll> blocked(a, from_origin_tag);
+        blocked_BIT<ll, 5> blocked5(a, from_origin_tag);
+        blocked_BIT<int> blocked32(a32, from_origin_tag);
+        blocked_BIT<unsigned, 2> blocked2(k);
+        std::vector<unsigned> au(k);
+        for (size_t it = 0; it < 200; ++it) {
+            const size_t i = rng() % k;
+            const ll d = static_cast<ll>(rng() % 19) - 9;
+            a[i] += d;
+            a32[i] += static_cast<int>(d);
+            au[i] += static_cast<unsigned>(d);
+            plain.add(i, d);
+            blocked.add(i, d);
+            blocked5.add(i, d);
+            blocked32.add(i, static_cast<int>(d));
+            blocked2.add(i, static_cast<unsigned>(d));
+            ll s = 0;
+            unsigned su = 0;
+            for (size_t j = 0; j < k; ++j) {
+                s += a[j];
+                su += au[j];
+                check(plain.sum(j) == s && blocked.sum(j) == s && blocked5.sum(j) == s,
+                      "prefix sums == naive");
+                check(blocked32.sum(j) == s && blocked2.sum(j) == su, "narrow blocked_BIT prefix sums == naive");
+            }
+        }
+    }
+
+    // 非负元素上的 lower_bound / partition_point 与线性扫描对拍
+    for (size_t k = 1; k <= 300; k += k < 70 ? 1 : 37) {
+        std::vector<ll> a(k);
+        for (auto &x: a)
+            x = static_cast<ll>(rng() % 4);
+        const binary_indexed_tree<ll> plain(a, from_origin_tag);
+        const ll total = plain.sum(k - 1);
+        for (ll val = 0; val <= total + 1; ++val) {
+            size_t expect = 0;
+            for (ll s = 0; expect < k && (s += a[expect]) < val;)
+                ++expect;
+            check(plain.lower_bound(val) == expect, "lower_bound == linear scan");
+            check(plain.partition_point([&](const ll x) { return x < val; }) == expect, "partition_point == linear scan");
+        }
+    }
+
+    std::printf("n = %zu, ops = %zu (half add, half sum)\n", n, m);
+    for (const bool sequential: {false, true}) {
+        bench_ops<int>(n, m, sequential, rng);
+        bench_ops<ll>(n, m, sequential, rng);
+    }
+
+    // 多线程只做 add, 结束后与单线程结果逐个前缀比较
+    std::vector<std::pair<size_t, ll> > adds(m / 2);
+    for (auto &[idx, delta]: adds) {
+        idx = rng() % n;
+        delta = static_cast<ll>(rng() % 1000) + 1;
+    }
+    binary_indexed_tree<ll> expect(n);
+    for (const auto &[idx, delta]: adds)
+        expect.add(idx, delta);
+    const auto concurrent_adds = [&](auto &bit) {
+        std::vector<std::jthread> workers;
+        for (size_t t = 0; t < threads; ++t)
+            workers.emplace_back([&, t] {
+                for (size_t i = t; i < adds.size(); i += threads)
+                    bit.add(adds[i].first, adds[i].second);
+            });
+    };
+    std::printf("%zu adds on %zu threads\n", adds.size(), threads);
+    concurrent_BIT<ll> conc(n);
+    sharded_BIT<ll> sharded(n, threads);
+    timed("concurrent_BIT", [&] { concurrent_adds(conc); });
+    timed("sharded_BIT", [&] { concurrent_adds(sharded); });
+    for (size_t i = 0; i < n; i += n / 1000 + 1)
+        check(conc.sum(i) == expect.sum(i) && sharded.sum(i) == expect.sum(i), "concurrent adds == sequential");
+    std::puts("ok");
+}
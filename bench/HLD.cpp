@@ -0,0 +1,63 @@
+// HLD 的 LCA 与朴素爬父亲对拍, 以及大规模 (含链状, 深度为 n) 树上的构造与 LCA 耗时
+// g++ -std=c++23 -O2 -pthread bench/HLD.cpp -o HLD && ./HLD [n] [queries]
+#include <random>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "../lib/data_structure/HLD.h"
+// 两个树剖线段树头文件须能同时包含
+#include "../lib/data_structure/range_sum_container/HLD.h"
+#include "../lib/data_structure/range_sum_container/HLD_seg_tree_binder.h"
+
+// 随机树 (父亲为更小编号的随机点) 或链, 以 0 为根
+std::vector<std::pair<size_t, size_t> > make_edges(const size_t n, const bool path, std::mt19937_64 &rng) {
+    std::vector<std::pair<size_t, size_t> > edges;
+    for (size_t i = 1; i < n; ++i)
+        edges.emplace_back(path ? i - 1 : rng() % i, i);
+    return edges;
+}
+
+size_t run_queries(HLD &hld, const std::vector<std::pair<size_t, size_t> > &qs) {
+    size_t acc = 0;
+    for (const auto &[u, v]: qs)
+        acc += hld.LCA(u, v);
+    return acc;
+}
+
+int main(const int argc, const char *argv[]) {
+    const size_t n = argc > 1 ? std::stoull(argv[1]) : 1uz << 21;
+    const size_t q = argc > 2 ? std::stoull(argv[2]) : 1uz << 22;
+    std::mt19937_64 rng(37);
+
+    for (size_t tc = 0; tc < 300; ++tc) {
+        const size_t k = rng() % 40 + 1;
+        const auto edges = make_edges(k, tc % 10 == 0, rng);
+        std::vector<size_t> par(k, ~0uz), depth(k);
+        for (const auto &[p, c]: edges) {
+            par[c] = p;
+            depth[c] = depth[p] + 1;
+        }
+        HLD hld(csr_tree(k, edges));
+        for (size_t it = 0; it < 100; ++it) {
+            size_t u = rng() % k, v = rng() % k;
+            const size_t got = hld.LCA(u, v);
+            while (u != v)
+                depth[u] >= depth[v] ? u = par[u] : v = par[v];
+            check(got == u, "LCA == naive");
+        }
+    }
+
+    for (const bool path: {false, true}) {
+        const auto edges = make_edges(n, path, rng);
+        std::vector<std::pair<size_t, size_t> > qs(q);
+        for (auto &[u, v]: qs) {
+            u = rng() % n;
+            v = rng() % n;
+        }
+        std::printf("n = %zu, %s\n", n, path ? "path" : "random tree");
+        HLD hld = timed("build", [&] { return HLD(csr_tree(n, edges)); });
+        const size_t acc = timed("LCA queries", [&] { return run_queries(hld, qs); });
+        std::printf("checksum %zu\n", acc);
+    }
+    std::puts("ok");
+}
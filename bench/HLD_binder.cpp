@@ -0,0 +1,119 @@
+// HLD_binder 批量路径查询与逐条 seg_query, 朴素爬父亲对拍 (含 subtree_modify 之后), 以及两者耗时
+// g++ -std=c++23 -O2 -pthread bench/HLD_binder.cpp -o HLD_binder && ./HLD_binder [n] [queries]
+#include <random>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "../lib/data_structure/range_sum_container/HLD_seg_tree_binder.h"
+
+using ll = long long;
+
+// 区间加, 区间求和
+struct add_tag {
+    ll add = 0;
+};
+
+struct sum_node {
+    ll sum = 0, len = 0;
+};
+
+add_tag operator*(const add_tag x, const add_tag y) { return {x.add + y.add}; }
+sum_node operator+(const sum_node x, const sum_node y) { return {x.sum + y.sum, x.len + y.len}; }
+sum_node operator*(const add_tag t, const sum_node x) { return {x.sum + t.add * x.len, x.len}; }
+
+using binder_t = HLD_binder<add_tag, sum_node>;
+
+std::vector<std::pair<size_t, size_t> > make_edges(const size_t n, std::mt19937_64 &rng) {
+    std::vector<std::pair<size_t, size_t> > edges;
+    for (size_t i = 1; i < n; ++i)
+        edges.emplace_back(rng() % i, i);
+    return edges;
+}
+
+std::vector<std::pair<size_t, size_t> > make_paths(const size_t n, const size_t q, std::mt19937_64 &rng) {
+    std::vector<std::pair<size_t, size_t> > paths(q);
+    for (auto &[u, v]: paths) {
+        u = rng() % n;
+        v = rng() % n;
+    }
+    return paths;
+}
+
+int main(const int argc, const char *argv[]) {
+    const size_t n = argc > 1 ? std::stoull(argv[1]) : 1uz << 20;
+    const size_t q = argc > 2 ? std::stoull(argv[2]) : 1uz << 20;
+    std::mt19937_64 rng(40);
+
+    for (size_t tc = 0; tc < 300; ++tc) {
+        const size_t k = rng() % 60 + 1;
+        const auto edges = make_edges(k, rng);
+        std::vector<size_t> par(k, ~0uz), depth(k);
+        for (const auto &[p, c]: edges) {
+            par[c] = p;
+            depth[c] = depth[p] + 1;
+        }
+        std::vector<ll> val(k);
+        std::vector<sum_node> data(k);
+        for (size_t i = 0; i < k; ++i)
+            data[i] = {val[i] = static_cast<ll>(rng() % 100), 1};
+        binder_t b(csr_tree(k, edges), data);
+
+        for (size_t it = 0; it < 30; ++it) {
+            const ll d = static_cast<ll>(rng() % 21) - 10;
+            if (rng() % 2) {
+                const size_t r = rng() % k;
+                b.subtree_modify(r, {d});
+                for (size_t x = 0; x < k; ++x) {
+                    size_t y = x;
+                    while (y != ~0uz && y != r)
+                        y = par[y];
+                    if (y == r)
+                        val[x] += d;
+                }
+            } else {
+                size_t u = rng() % k, v = rng() % k;
+                b.seg_modify(u, v, {d});
+                for (; u != v; depth[u] >= depth[v] ? u = par[u] : v = par[v])
+                    val[depth[u] >= depth[v] ? u : v] += d;
+                val[u] += d;
+            }
+
+            // 小批量走逐区间 query, 大批量走一次性下放标记后的只读查询, 两条分支都要覆盖
+            const auto paths = make_paths(k, rng() % 2 ? 1 : 4 * k, rng);
+            const auto batched = b.seg_query(paths);
+            for (size_t i = 0; i < paths.size(); ++i) {
+                auto [u, v] = paths[i];
+                ll expect = 0;
+                for (; u != v; depth[u] >= depth[v] ? u = par[u] : v = par[v])
+                    expect += val[depth[u] >= depth[v] ? u : v];
+                expect += val[u];
+                check(batched[i].sum == expect, "batched seg_query == naive");
+                check(b.seg_query(paths[i].first, paths[i].second).sum == expect, "seg_query == naive");
+            }
+        }
+    }
+
+    const auto edges = make_edges(n, rng);
+    std::vector<sum_node> data(n, {1, 1});
+    const auto paths = make_paths(n, q, rng);
+    std::printf("n = %zu, %zu path queries after %zu subtree modifications\n", n, q, n / 64);
+    const auto run = [&](const bool batched) {
+        binder_t b(csr_tree(n, edges), data);
+        for (size_t i = 0; i < n / 64; ++i)
+            b.subtree_modify(i * 64 % n, {1});
+        return timed(batched ? "batched seg_query" : "seg_query per path", [&] {
+            ll acc = 0;
+            if (batched)
+                for (const auto &x: b.seg_query(paths))
+                    acc += x.sum;
+            else
+                for (const auto &[u, v]: paths)
+                    acc += b.seg_query(u, v).sum;
+            return acc;
+        });
+    };
+    const ll one = run(false), all = run(true);
+    check(one == all, "batched == per path (large)");
+    std::printf("checksum %lld\n", all);
+    std::puts("ok");
+}
@@ -0,0 +1,46 @@
+#ifndef BENCH_H
+#define BENCH_H
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+
+// 独立的校验与计时小程序共用, 每个 bench/*.cpp 单独编译运行:
+// g++ -std=c++23 -O2 -pthread bench/xxx.cpp -o xxx && ./xxx
+
+// 运行 f 并打印耗时, 返回 f 的结果
+template<typename F>
+decltype(auto) timed(const char *name, F f) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto report = [&] {
+        const std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start;
+        std::printf("%-48s %10.3f ms\n", name, ms.count());
+    };
+    if constexpr (std::is_void_v<std::invoke_result_t<F> >) {
+        f();
+        report();
+    } else {
+        auto res = f();
+        report();
+        return res;
+    }
+}
+
+// 运行 f 并返回耗时 (毫秒), 不打印, 用于需要自行比较或排版的场合
+template<typename F>
+double time_ms(F f) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start;
+    return ms.count();
+}
+
+// 校验失败时打印并以非零值退出
+inline void check(const bool ok, const char *what) {
+    if (!ok) {
+        std::fprintf(stderr, "check failed: %s\n", what);
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+#endif //BENCH_H
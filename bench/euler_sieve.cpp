@@ -0,0 +1,29 @@
+// multiplicative_sieve 与朴素枚举约数的对拍 (T = int, 覆盖 p * p^k 溢出 int 的情形), 以及筛的耗时
+// g++ -std=c++23 -O2 -pthread bench/euler_sieve.cpp -o euler_sieve && ./euler_sieve
+#include <memory>
+#include "bench.h"
+#include "../lib/number/euler_sieve.h"
+
+constexpr size_t N = 100000;
+using sieve_t = multiplicative_sieve<int, N, phi_policy, mu_policy, sigma0_policy, sigma1_policy>;
+
+int main() {
+    const auto s = timed("multiplicative_sieve<int, 1e5>, 4 functions", [] { return std::make_unique<sieve_t>(); });
+    const auto e = std::make_unique<euler_sieve<int, N, true, true> >();
+    const auto &phi = s->get<phi_policy>(), &mu = s->get<mu_policy>();
+    const auto &d = s->get<sigma0_policy>(), &sigma = s->get<sigma1_policy>();
+
+    for (int n = 1; n <= static_cast<int>(N); ++n) {
+        long long cnt = 0, sum = 0;
+        for (int i = 1; i * i <= n; ++i) {
+            if (n % i)
+                continue;
+            cnt += i * i == n ? 1 : 2;
+            sum += i * i == n ? i : i + n / i;
+        }
+        check(d[n] == cnt, "sigma0 == brute force");
+        check(sigma[n] == sum, "sigma1 == brute force");
+        check(phi[n] == e->phi[n] && mu[n] == e->mu[n], "phi, mu == euler_sieve");
+    }
+    std::puts("ok");
+}
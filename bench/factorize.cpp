@@ -0,0 +1,70 @@
+// is_prime / factorize 与朴素试除的对拍, 以及批量随机 64 位数的耗时
+// g++ -std=c++23 -O2 -pthread bench/factorize.cpp -o factorize && ./factorize [count]
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "../lib/number/prime.h"
+
+int main(const int argc, const char *argv[]) {
+    const size_t count = argc > 1 ? std::stoull(argv[1]) : 100000;
+    std::mt19937_64 rng(44);
+
+    for (unsigned n = 0; n < 200000; ++n)
+        check(is_prime(n) == is_prime_naive(n), "is_prime == naive (small)");
+    // 强伪素数与 2^64 附近的值
+    check(!is_prime(3825123056546413051ull), "strong pseudoprime to bases 2..37");
+    check(is_prime(18446744073709551557ull), "largest 64-bit prime");
+    check(!is_prime(18446744073709551615ull), "2^64 - 1");
+
+    for (size_t it = 0; it < 20000; ++it) {
+        const ull n = std::max<ull>(rng() >> rng() % 64, 1);
+        std::vector<ull> f;
+        factorize(n, std::back_inserter(f));
+        ull prod = 1;
+        for (const ull p: f) {
+            check(is_prime(p), "factors are prime");
+            prod *= p;
+        }
+        check(prod == n && std::ranges::is_sorted(f), "factors multiply back, sorted");
+        if (n < 1ull << 36) {
+            std::vector<ull> g;
+            get_factors(n, std::back_inserter(g));
+            check(f == g, "factorize == get_factors");
+        }
+    }
+
+    std::vector<ull> nums(count);
+    for (auto &x: nums)
+        x = rng();
+    // 两个相邻的约 32 位素数之积, Pollard-rho 的最坏情形
+    std::vector<ull> semiprimes;
+    for (ull p = (1ull << 32) - 1, last = 0; semiprimes.size() < count / 100; p -= 2) {
+        if (!is_prime(p))
+            continue;
+        if (last)
+            semiprimes.push_back(p * last);
+        last = p;
+    }
+    std::printf("%zu random 64-bit numbers, %zu products of two ~32-bit primes\n", count, semiprimes.size());
+
+    const size_t primes = timed("is_prime", [&] {
+        return static_cast<size_t>(std::ranges::count_if(nums, [](const ull x) { return is_prime(x); }));
+    });
+    const auto run = [](const std::vector<ull> &v) {
+        size_t total = 0;
+        std::vector<ull> f;
+        for (const ull x: v) {
+            f.clear();
+            factorize(x, std::back_inserter(f));
+            total += f.size();
+        }
+        return total;
+    };
+    const size_t factors = timed("factorize random", [&] { return run(nums); });
+    const size_t hard = timed("factorize p * q, p, q ~ 2^32", [&] { return run(semiprimes); });
+    std::printf("primes %zu, factors %zu, %zu\n", primes, factors, hard);
+    std::puts("ok");
+}
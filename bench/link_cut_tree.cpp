@@ -0,0 +1,273 @@
+// link_cut_tree 与朴素森林 (bfs 求路径) 的对拍, 大规模随机操作的耗时, 以及与逐次重建树剖的吞吐对比
+// g++ -std=c++23 -O2 -pthread bench/link_cut_tree.cpp -o link_cut_tree && ./link_cut_tree [n] [ops] [cmp_n] [cmp_ops]
+#include <algorithm>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "../lib/data_structure/link_cut_tree.h"
+#include "../lib/data_structure/range_sum_container/HLD.h"
+
+using ll = long long;
+
+struct add_tag {
+    ll k = 0;
+
+    add_tag operator*(const add_tag o) const {
+        return {k + o.k};
+    }
+};
+
+struct path_sum {
+    ll s = 0, len = 0;
+
+    path_sum operator+(const path_sum o) const {
+        return {s + o.s, len + o.len};
+    }
+};
+
+template<>
+constexpr bool is_commutative_v<path_sum> = true;
+
+path_sum operator*(const add_tag t, const path_sum x) {
+    return {x.s + t.k * x.len, x.len};
+}
+
+// 按 u -> v 顺序拼接标签, 用于检查非交换的 G
+struct concat {
+    std::string s;
+
+    concat operator+(const concat &o) const {
+        return {s + o.s};
+    }
+};
+
+struct shift_tag {
+    int k = 0;
+
+    shift_tag operator*(const shift_tag o) const {
+        return {k + o.k};
+    }
+};
+
+concat operator*(const shift_tag t, concat x) {
+    for (char &c: x.s)
+        c = static_cast<char>('a' + (c - 'a' + t.k) % 26);
+    return x;
+}
+
+std::optional<std::vector<size_t> > naive_path(const std::vector<std::vector<size_t> > &adj, const size_t u,
+                                               const size_t v) {
+    std::vector<size_t> from(adj.size(), ~0uz), queue{u};
+    from[u] = u;
+    for (size_t i = 0; i < queue.size(); ++i)
+        for (const size_t y: adj[queue[i]])
+            if (!~from[y]) {
+                from[y] = queue[i];
+                queue.push_back(y);
+            }
+    if (!~from[v])
+        return std::nullopt;
+    std::vector<size_t> path{v};
+    for (size_t x = v; x != u; x = from[x])
+        path.push_back(from[x]);
+    std::ranges::reverse(path);
+    return path;
+}
+
+// 随机操作序列, 按 op % 8 分为 link : cut : 路径加 : 路径和 = 3 : 1 : 2 : 2; cut 时删除第 r % edges 条现有边
+struct op_t {
+    size_t u, v, r;
+};
+
+std::vector<op_t> make_ops(const size_t m, const size_t n, std::mt19937_64 &rng) {
+    std::vector<op_t> ops(m);
+    for (auto &[u, v, r]: ops) {
+        u = rng() % n;
+        v = rng() % n;
+        r = rng();
+    }
+    return ops;
+}
+
+ll run_lct(const size_t n, const std::vector<op_t> &ops) {
+    link_cut_tree<add_tag, path_sum> lct(std::vector(n, path_sum{1, 1}));
+    std::vector<std::pair<size_t, size_t> > edges;
+    ll res = 0;
+    for (size_t op = 0; op < ops.size(); ++op) {
+        const auto [u, v, r] = ops[op];
+        switch (op % 8) {
+            case 0:
+            case 1:
+            case 2:
+                if (lct.link(u, v))
+                    edges.emplace_back(u, v);
+                break;
+            case 3:
+                if (!edges.empty()) {
+                    std::swap(edges[r % edges.size()], edges.back());
+                    check(lct.cut(edges.back().first, edges.back().second), "cut existing edge");
+                    edges.pop_back();
+                }
+                break;
+            case 4:
+            case 5:
+                if (lct.is_linked(u, v))
+                    lct.modify(u, v, {1});
+                break;
+            default:
+                if (lct.is_linked(u, v))
+                    res += lct.query(u, v).s;
+        }
+    }
+    return res;
+}
+
+// 对照组: 森林每次改动后, 在下一次路径操作前把点权读出, 从头重建 forward_HLD
+// 各连通块的根挂到虚根 0 上 (原编号整体加一), 连通性由重建时求出的块编号判断
+ll run_rebuilt_HLD(const size_t n, const std::vector<op_t> &ops) {
+    using hld_t = forward_HLD<add_tag, path_sum>;
+    std::vector<path_sum> val(n + 1, path_sum{1, 1});
+    val[0] = {};
+    std::vector<std::pair<size_t, size_t> > edges;
+    std::vector<size_t> comp(n + 1);
+    std::iota(comp.begin(), comp.end(), 0uz);
+    std::optional<hld_t> hld;
+    bool dirty = true;
+
+    const auto find = [&](size_t x) {
+        while (comp[x] != x)
+            x = comp[x] = comp[comp[x]];
+        return x;
+    };
+    const auto rebuild = [&] {
+        if (hld) {
+            hld->resolve_all_tags();
+            for (size_t i = 1; i <= n; ++i)
+                val[i] = hld->get_unchecked(i);
+        }
+        std::iota(comp.begin(), comp.end(), 0uz);
+        std::vector<std::pair<size_t, size_t> > tree_edges;
+        tree_edges.reserve(n);
+        for (const auto &[u, v]: edges) {
+            comp[find(u + 1)] = find(v + 1);
+            tree_edges.emplace_back(u + 1, v + 1);
+        }
+        for (size_t i = 1; i <= n; ++i)
+            if (find(i) == i)
+                tree_edges.emplace_back(0, i);
+        hld.emplace(csr_tree(n + 1, tree_edges), val);
+        dirty = false;
+    };
+    const auto linked = [&](const size_t u, const size_t v) {
+        if (dirty)
+            rebuild();
+        return find(u + 1) == find(v + 1);
+    };
+
+    ll res = 0;
+    for (size_t op = 0; op < ops.size(); ++op) {
+        const auto [u, v, r] = ops[op];
+        switch (op % 8) {
+            case 0:
+            case 1:
+            case 2:
+                if (!linked(u, v)) {
+                    edges.emplace_back(u, v);
+                    dirty = true;
+                }
+                break;
+            case 3:
+                if (!edges.empty()) {
+                    std::swap(edges[r % edges.size()], edges.back());
+                    edges.pop_back();
+                    dirty = true;
+                }
+                break;
+            case 4:
+            case 5:
+                if (linked(u, v))
+                    hld->seg_modify(u + 1, v + 1, {1});
+                break;
+            default:
+                if (linked(u, v))
+                    res += hld->seg_query(u + 1, v + 1).s;
+        }
+    }
+    return res;
+}
+
+int main(const int argc, const char *argv[]) {
+    const size_t n = argc > 1 ? std::stoull(argv[1]) : 200000;
+    const size_t m = argc > 2 ? std::stoull(argv[2]) : 2000000;
+    const size_t cmp_n = argc > 3 ? std::stoull(argv[3]) : 5000;
+    const size_t cmp_m = argc > 4 ? std::stoull(argv[4]) : 40000;
+    std::mt19937_64 rng(41);
+
+    for (size_t tc = 0; tc < 200; ++tc) {
+        const size_t k = rng() % 12 + 1;
+        std::vector<std::vector<size_t> > adj(k);
+        std::string label(k, 'a');
+        std::vector<concat> init(k);
+        for (size_t i = 0; i < k; ++i) {
+            label[i] = static_cast<char>('a' + rng() % 26);
+            init[i] = {std::string(1, label[i])};
+        }
+        link_cut_tree<shift_tag, concat> lct(init);
+        for (size_t op = 0; op < 200; ++op) {
+            const size_t u = rng() % k, v = rng() % k;
+            const auto path = naive_path(adj, u, v);
+            switch (rng() % 4) {
+                case 0:
+                    check(lct.link(u, v) == !path, "link == naive");
+                    if (!path) {
+                        adj[u].push_back(v);
+                        adj[v].push_back(u);
+                    }
+                    break;
+                case 1: {
+                    const bool has = std::ranges::count(adj[u], v);
+                    check(lct.cut(u, v) == has, "cut == naive");
+                    if (has) {
+                        std::erase(adj[u], v);
+                        std::erase(adj[v], u);
+                    }
+                    break;
+                }
+                case 2:
+                    check(lct.is_linked(u, v) == path.has_value(), "is_linked == naive");
+                    if (path) {
+                        std::string s;
+                        for (const size_t x: *path)
+                            s += label[x];
+                        check(lct.query(u, v).s == s, "ordered path query == naive");
+                    }
+                    break;
+                default:
+                    if (path) {
+                        const int t = static_cast<int>(rng() % 3) + 1;
+                        lct.modify(u, v, {t});
+                        for (const size_t x: *path)
+                            label[x] = static_cast<char>('a' + (label[x] - 'a' + t) % 26);
+                    }
+            }
+        }
+    }
+
+    // 大规模: 维护随机森林, link : cut : 路径加 : 路径和 = 3 : 1 : 2 : 2, 森林逐渐连成大树
+    std::printf("n = %zu, ops = %zu\n", n, m);
+    const auto large = make_ops(m, n, rng);
+    const ll acc = timed("link_cut_tree random ops", [&] { return run_lct(n, large); });
+    std::printf("checksum %lld\n", acc);
+
+    // 同一操作序列上与 "每次改动森林后重建树剖" 对比, 重建为 O(n), 只能在较小规模上跑
+    std::printf("n = %zu, ops = %zu, link_cut_tree vs forward_HLD rebuilt after each link/cut\n", cmp_n, cmp_m);
+    const auto small = make_ops(cmp_m, cmp_n, rng);
+    const ll lct_acc = timed("link_cut_tree", [&] { return run_lct(cmp_n, small); });
+    const ll hld_acc = timed("forward_HLD rebuild", [&] { return run_rebuilt_HLD(cmp_n, small); });
+    check(lct_acc == hld_acc, "link_cut_tree == rebuilt forward_HLD");
+    std::printf("checksum %lld\n", lct_acc);
+    std::puts("ok");
+}
@@ -0,0 +1,90 @@
+// 并行构造与顺序构造的结果一致性, 以及 1 到 max_threads 线程的扩展性
+// g++ -std=c++23 -O2 -pthread bench/parallel_build.cpp -o parallel_build && ./parallel_build [n] [max_threads]
+#include <random>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "../lib/data_structure/range_sum_container/sparse_table.h"
+#include "../lib/data_structure/range_sum_container/wrappers.h"
+#include "../lib/data_structure/range_sum_container/zkw_seg_tree.h"
+
+using ll = long long;
+
+struct add_tag {
+    ll k = 0;
+
+    add_tag operator*(const add_tag o) const {
+        return {k + o.k};
+    }
+};
+
+struct range_sum {
+    ll s = 0, len = 0;
+
+    range_sum operator+(const range_sum o) const {
+        return {s + o.s, len + o.len};
+    }
+};
+
+range_sum operator*(const add_tag t, const range_sum x) {
+    return {x.s + t.k * x.len, x.len};
+}
+
+struct inputs {
+    std::vector<range_sum> v;
+    std::vector<min_wrapper<ll> > w;
+};
+
+inputs make_inputs(const size_t n, std::mt19937_64 &rng) {
+    inputs in{std::vector<range_sum>(n), std::vector<min_wrapper<ll> >(n)};
+    for (auto &x: in.v)
+        x = {static_cast<ll>(rng() % 1000), 1};
+    for (auto &x: in.w)
+        x = static_cast<ll>(rng() % 1000000);
+    return in;
+}
+
+void compare(const size_t n, const size_t threads, std::mt19937_64 &rng) {
+    const auto [v, w] = make_inputs(n, rng);
+    zkw_seg_tree<add_tag, range_sum> seq(v), par(v, parallel_tag, threads);
+    const sparse_table<min_wrapper<ll> > st_seq(w), st_par(w, parallel_tag, threads);
+
+    for (size_t q = 0; q < 10000 && n; ++q) {
+        size_t l = rng() % n, r = rng() % n;
+        if (l > r)
+            std::swap(l, r);
+        ++r;
+        check(seq.query(l, r).s == par.query(l, r).s, "zkw_seg_tree parallel == sequential");
+        check(static_cast<ll>(st_seq.query(l, r)) == static_cast<ll>(st_par.query(l, r)),
+              "sparse_table parallel == sequential");
+    }
+}
+
+int main(const int argc, const char *argv[]) {
+    const size_t n = argc > 1 ? std::stoull(argv[1]) : 1uz << 23;
+    const size_t max_threads = argc > 2 ? std::stoull(argv[2]) : default_thread_count();
+    std::mt19937_64 rng(26);
+
+    // 边界规模, 以及跨过 parallel_for 粒度的规模; 线程数至少试到 4, 单核机器上也覆盖多段切分
+    for (size_t t = 1; t <= std::max(max_threads, 4uz); t <<= 1)
+        for (const size_t m: {0uz, 1uz, 2uz, 5uz, 1000uz, (1uz << 15) + 3, 1uz << 17, (1uz << 18) + 7})
+            compare(m, t, rng);
+
+    // 从 1 线程到 max_threads 的扩展性, 加速比相对顺序构造
+    const auto [v, w] = make_inputs(n, rng);
+    const double zkw_seq = time_ms([&] { zkw_seg_tree<add_tag, range_sum> t(v); });
+    const double st_seq = time_ms([&] { sparse_table<min_wrapper<ll> > t(w); });
+    std::printf("n = %zu, hardware threads = %zu\n", n, default_thread_count());
+    std::printf("%8s %14s %9s %14s %9s\n", "threads", "zkw ms", "speedup", "sparse ms", "speedup");
+    std::printf("%8s %14.3f %9s %14.3f %9s\n", "seq", zkw_seq, "1.00", st_seq, "1.00");
+    std::vector<size_t> steps;
+    for (size_t t = 1; t < max_threads; t <<= 1)
+        steps.push_back(t);
+    steps.push_back(max_threads);
+    for (const size_t t: steps) {
+        const double zkw = time_ms([&] { zkw_seg_tree<add_tag, range_sum> tr(v, parallel_tag, t); });
+        const double st = time_ms([&] { sparse_table<min_wrapper<ll> > tr(w, parallel_tag, t); });
+        std::printf("%8zu %14.3f %9.2f %14.3f %9.2f\n", t, zkw, zkw_seq / zkw, st, st_seq / st);
+    }
+    std::puts("ok");
+}
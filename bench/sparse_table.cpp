@@ -0,0 +1,95 @@
+// sparse_table 与 disjoint_sparse_table 的正确性, 内存项数与查询耗时
+// g++ -std=c++23 -O2 -pthread bench/sparse_table.cpp -o sparse_table && ./sparse_table [n] [queries]
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <random>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "../lib/data_structure/LCA.h"
+#include "../lib/number/prime_counting.h" // 经 math.h, 与 LCA.h 同时包含时不得重复定义 saturating_sub
+#include "../lib/data_structure/range_sum_container/disjoint_sparse_table.h"
+#include "../lib/data_structure/range_sum_container/sparse_table.h"
+#include "../lib/data_structure/range_sum_container/wrappers.h"
+
+using ll = long long;
+
+struct plus_sg {
+    ll s = 0;
+
+    plus_sg operator+(const plus_sg o) const {
+        return {s + o.s};
+    }
+
+    plus_sg &operator+=(const plus_sg o) {
+        s += o.s;
+        return *this;
+    }
+};
+
+int main(const int argc, const char *argv[]) {
+    const size_t n = argc > 1 ? std::stoull(argv[1]) : 1uz << 22;
+    const size_t q = argc > 2 ? std::stoull(argv[2]) : 1uz << 23;
+    std::mt19937_64 rng(27);
+
+    // 小规模对拍所有区间
+    for (size_t m = 0; m <= 70; ++m) {
+        std::vector<min_wrapper<ll> > w(m);
+        std::vector<plus_sg> p(m);
+        for (size_t i = 0; i < m; ++i) {
+            w[i] = static_cast<ll>(rng() % 1000);
+            p[i] = {static_cast<ll>(rng() % 1000)};
+        }
+        const sparse_table<min_wrapper<ll> > st(w);
+        const disjoint_sparse_table<plus_sg> dst(p);
+        for (size_t l = 0; l < m; ++l) {
+            ll mn = LLONG_MAX, s = 0;
+            for (size_t r = l; r < m; ++r) {
+                mn = std::min(mn, static_cast<ll>(w[r]));
+                s += p[r].s;
+                check(static_cast<ll>(st.query(l, r + 1)) == mn, "sparse_table == naive min");
+                check(dst.query(l, r + 1).s == s, "disjoint_sparse_table == naive sum");
+            }
+        }
+    }
+
+    std::vector<min_wrapper<ll> > w(n);
+    std::vector<plus_sg> p(n);
+    for (size_t i = 0; i < n; ++i) {
+        w[i] = static_cast<ll>(rng());
+        p[i] = {static_cast<ll>(rng() % 1000)};
+    }
+    std::vector<std::pair<size_t, size_t> > qs(q);
+    for (auto &[l, r]: qs) {
+        l = rng() % n;
+        r = rng() % n;
+        if (l > r)
+            std::swap(l, r);
+        ++r;
+    }
+
+    const sparse_table<min_wrapper<ll> > st = timed("sparse_table build", [&] {
+        return sparse_table<min_wrapper<ll> >(w);
+    });
+    const disjoint_sparse_table<plus_sg> dst = timed("disjoint_sparse_table build", [&] {
+        return disjoint_sparse_table<plus_sg>(p);
+    });
+    // 每层存满 n 项的旧布局与当前扁平布局的项数
+    std::printf("n = %zu, entries per-level-full = %zu, flat = %zu\n", n, n * std::bit_width(n), st.data.size());
+
+    const ll a = timed("sparse_table queries", [&] {
+        ll acc = 0;
+        for (const auto &[l, r]: qs)
+            acc ^= static_cast<ll>(st.query(l, r));
+        return acc;
+    });
+    const ll b = timed("disjoint_sparse_table queries", [&] {
+        ll acc = 0;
+        for (const auto &[l, r]: qs)
+            acc ^= dst.query(l, r).s;
+        return acc;
+    });
+    std::printf("checksum %lld %lld\n", a, b);
+    std::puts("ok");
+}
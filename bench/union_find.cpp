@@ -0,0 +1,114 @@
+// 并查集与朴素染色的对拍, 以及大规模随机 link / is_linked 的耗时
+// g++ -std=c++23 -O2 -pthread bench/union_find.cpp -o union_find && ./union_find [n] [ops] [threads]
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "../lib/data_structure/concurrent_union_find.h"
+#include "../lib/data_structure/union_find.h"
+#include "../lib/parallel.h"
+
+// 改为非递归, 压缩存储之前的实现, 作为对照
+struct recursive_union_find {
+    std::vector<size_t> par, _size;
+
+    explicit recursive_union_find(const size_t n): par(n), _size(n, 1) {
+        std::iota(par.begin(), par.end(), 0);
+    }
+
+    size_t root(const size_t n) {
+        return par[n] == n ? n : par[n] = root(par[n]);
+    }
+
+    bool link(const size_t x, const size_t y) {
+        size_t rx = root(x), ry = root(y);
+        if (rx == ry)
+            return false;
+        if (_size[rx] > _size[ry])
+            std::swap(rx, ry);
+        par[rx] = ry;
+        _size[ry] += _size[rx];
+        return true;
+    }
+
+    bool is_linked(const size_t x, const size_t y) {
+        return root(x) == root(y);
+    }
+};
+
+// ops 中前一半为 link, 后一半为 is_linked, 返回成功次数
+template<typename UF>
+size_t run_ops(UF &uf, const std::vector<std::pair<size_t, size_t> > &ops) {
+    size_t cnt = 0;
+    for (size_t i = 0; i < ops.size(); ++i)
+        cnt += i < ops.size() / 2 ? uf.link(ops[i].first, ops[i].second) : uf.is_linked(ops[i].first, ops[i].second);
+    return cnt;
+}
+
+int main(const int argc, const char *argv[]) {
+    const size_t n = argc > 1 ? std::stoull(argv[1]) : 1uz << 22;
+    const size_t m = argc > 2 ? std::stoull(argv[2]) : 1uz << 23;
+    const size_t threads = argc > 3 ? std::stoull(argv[3]) : default_thread_count();
+    std::mt19937_64 rng(33);
+
+    {
+        constexpr size_t k = 500;
+        union_find uf(k);
+        std::vector<size_t> color(k);
+        std::iota(color.begin(), color.end(), 0uz);
+        for (size_t it = 0; it < 5000; ++it) {
+            const size_t x = rng() % k, y = rng() % k;
+            const size_t cx = color[x], cy = color[y];
+            check(uf.link(x, y) == (cx != cy), "link == naive");
+            std::ranges::replace(color, cx, cy);
+            const size_t p = rng() % k, q = rng() % k;
+            check(uf.is_linked(p, q) == (color[p] == color[q]), "is_linked == naive");
+            check(uf.size(p) == static_cast<size_t>(std::ranges::count(color, color[p])), "size == naive");
+        }
+    }
+
+    std::vector<std::pair<size_t, size_t> > ops(m);
+    for (auto &[x, y]: ops) {
+        x = rng() % n;
+        y = rng() % n;
+    }
+    std::printf("n = %zu, ops = %zu (half link, half is_linked)\n", n, m);
+    recursive_union_find old_uf(n);
+    union_find uf(n);
+    const size_t a = timed("recursive union_find (previous)", [&] { return run_ops(old_uf, ops); });
+    const size_t b = timed("union_find", [&] { return run_ops(uf, ops); });
+    check(a == b, "union_find == previous implementation");
+
+    // 多线程同时 link 与 is_linked, 结束后连通性须与顺序执行全部 link 的结果一致
+    concurrent_union_find cuf(n);
+    const size_t c = timed("concurrent_union_find", [&] {
+        std::atomic<size_t> cnt = 0;
+        std::vector<std::jthread> workers;
+        for (size_t t = 0; t < threads; ++t)
+            workers.emplace_back([&, t] {
+                size_t local = 0;
+                for (size_t i = t; i < ops.size(); i += threads)
+                    if (i < ops.size() / 2)
+                        local += cuf.link(ops[i].first, ops[i].second);
+                    else
+                        cuf.is_linked(ops[i].first, ops[i].second);
+                cnt += local;
+            });
+        workers.clear();
+        return cnt.load();
+    });
+    std::printf("%zu threads\n", threads);
+    size_t comps = 0;
+    for (size_t i = 0; i < n; ++i)
+        comps += uf.root(i) == i;
+    check(c == n - comps, "concurrent links merge as many sets as sequential links");
+    for (size_t i = 0; i < 100000; ++i) {
+        const size_t x = rng() % n, y = rng() % n;
+        check(cuf.is_linked(x, y) == uf.is_linked(x, y), "concurrent_union_find == union_find");
+    }
+    std::puts("ok");
+}
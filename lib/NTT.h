@@ -0,0 +1,74 @@
+#ifndef NTT_H
+#define NTT_H
+#include <bit>
+#include <vector>
+#include "FFT.h"
+#include "math.h"
+
+using ull = unsigned long long;
+
+// 模 MOD 的数论变换, G 为原根, 要求 vec.size() 为 2 的幂且整除 MOD - 1
+template<ull MOD, ull G = 3>
+void NTT(std::vector<ull> &vec, const bool is_normal) {
+    const size_t n = vec.size();
+    const std::vector<size_t> rev = get_rev(std::__lg(n));
+    for (size_t i = 0; i < n; ++i)
+        if (i < rev[i])
+            std::swap(vec[i], vec[rev[i]]);
+
+    for (size_t i = 2; i <= n; i <<= 1) {
+        const ull w = fast_pow<ull>(G, (MOD - 1) / i, MOD);
+        const ull w1 = is_normal ? w : fast_pow<ull>(w, MOD - 2, MOD);
+        for (auto j = vec.begin(); j != vec.end(); j += i) {
+            ull wk = 1;
+            for (auto k = j; k != j + (i >> 1); ++k) {
+                const ull x = *k, y = *(k + (i >> 1)) * wk % MOD;
+                *k = x + y >= MOD ? x + y - MOD : x + y;
+                *(k + (i >> 1)) = x >= y ? x - y : x + MOD - y;
+                wk = wk * w1 % MOD;
+            }
+        }
+    }
+
+    if (!is_normal) {
+        const ull inv_n = fast_pow<ull>(n, MOD - 2, MOD);
+        for (auto &i: vec)
+            i = i * inv_n % MOD;
+    }
+}
+
+template<ull MOD, ull G = 3>
+std::vector<ull> NTT_convolution(std::vector<ull> a, std::vector<ull> b) {
+    const size_t len = a.size() + b.size() - 1, n = std::bit_ceil(len);
+    a.resize(n);
+    b.resize(n);
+    NTT<MOD, G>(a, true);
+    NTT<MOD, G>(b, true);
+    for (size_t i = 0; i < n; ++i)
+        a[i] = a[i] * b[i] % MOD;
+    NTT<MOD, G>(a, false);
+    a.resize(len);
+    return a;
+}
+
+// 任意模数 (< 2^32) 卷积: 三个 NTT 模数分别卷积后用 Garner 算法合并, 要求 len * mod^2 < 998244353 * 167772161 * 469762049
+inline std::vector<ull> convolution_mod(const std::vector<ull> &a, const std::vector<ull> &b, const ull mod) {
+    if (a.empty() || b.empty())
+        return {};
+    constexpr ull m1 = 998244353, m2 = 167772161, m3 = 469762049;
+    const std::vector<ull> c1 = NTT_convolution<m1>(a, b), c2 = NTT_convolution<m2>(a, b),
+            c3 = NTT_convolution<m3>(a, b);
+    const ull inv_m1 = fast_pow<ull>(m1, m2 - 2, m2), inv_m12 = fast_pow<ull>(m1 * m2 % m3, m3 - 2, m3);
+    const ull m12 = m1 * m2 % mod;
+    std::vector<ull> ans(c1.size());
+    for (size_t i = 0; i < ans.size(); ++i) {
+        // x = c1 + m1 * t2 + m1 * m2 * t3
+        const ull t2 = (c2[i] + m2 - c1[i] % m2) * inv_m1 % m2;
+        const ull x12 = (c1[i] + m1 * t2) % m3;
+        const ull t3 = (c3[i] + m3 - x12) * inv_m12 % m3;
+        ans[i] = (c1[i] % mod + m1 % mod * t2 % mod + m12 * t3) % mod;
+    }
+    return ans;
+}
+
+#endif //NTT_H
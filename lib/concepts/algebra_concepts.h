@@ -8,6 +8,10 @@ concept communicate = true; // axiom(T x, T y): x + y == y + x
 template<typename T>
 concept idempotent = true; // axiom(T x): x + x == x
 
+// 交换律无法在编译期检查, 对满足 communicate 的类型特化为 true 以启用依赖交换律的优化
+template<typename T>
+constexpr bool is_commutative_v = false;
+
 template<typename T>
 concept semigroup = requires(T x, T y)
 {
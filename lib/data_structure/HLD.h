@@ -3,41 +3,58 @@
 #include <vector>
 #include <cassert>
 #include <algorithm>
+#include "csr_tree.h"
 
 struct HLD {
-    std::vector<std::vector<size_t> > edges;
+    csr_tree tree;
     size_t _size;
     std::vector<size_t> depth, fa, size, heavy_child;
     std::vector<size_t> head, dfn, inv_dfn;
 
-    explicit HLD(std::vector<std::vector<size_t> > edges_) : edges(std::move(edges_)), _size(edges.size()),
-                                                             depth(_size), fa(_size), size(_size, 1uz),
-                                                             heavy_child(_size, ~0uz), head(_size), dfn(_size),
-                                                             inv_dfn(_size) {
-        auto dfs1 = [&](auto &&self, const size_t cur, const size_t from) -> void {
-            depth[cur] = ~from ? depth[from] + 1 : 0;
-            fa[cur] = ~from ? from : ~0uz;
-            for (const size_t nxt: edges[cur]) {
-                if (nxt != from) {
-                    self(self, nxt, cur);
-                    size[cur] += size[nxt];
-                    if (!~heavy_child[cur] || size[nxt] > size[heavy_child[cur]])
-                        heavy_child[cur] = nxt;
+    explicit HLD(const std::vector<std::vector<size_t> > &edges) : HLD(csr_tree(edges)) {
+    }
+
+    // 全程不递归: bfs 序求深度, 父亲, 子树大小和重儿子, 再用显式栈逐条重链分配 dfn
+    explicit HLD(csr_tree tree_) : tree(std::move(tree_)), _size(tree.size()), depth(_size), fa(_size),
+                                   size(_size, 1uz), heavy_child(_size, ~0uz), head(_size), dfn(_size),
+                                   inv_dfn(_size) {
+        if (!_size)
+            return;
+
+        std::vector<size_t> order(_size);
+        fa[0] = ~0uz;
+        for (size_t i = 0, tail = 1; i < tail; ++i) {
+            const size_t cur = order[i];
+            for (const size_t nxt: tree[cur]) {
+                if (nxt != fa[cur]) {
+                    fa[nxt] = cur;
+                    depth[nxt] = depth[cur] + 1;
+                    order[tail++] = nxt;
                 }
             }
-        };
-        dfs1(dfs1, 0uz, ~0uz);
+        }
+        for (size_t i = _size - 1; i; --i) {
+            const size_t cur = order[i], from = fa[cur];
+            size[from] += size[cur];
+            if (!~heavy_child[from] || size[cur] > size[heavy_child[from]])
+                heavy_child[from] = cur;
+        }
 
-        auto dfs2 = [&, time_stamp = 0uz](auto &&self, const size_t cur, const size_t cur_head) mutable -> void {
-            dfn[cur] = time_stamp++;
-            head[cur] = cur_head;
-            if (~heavy_child[cur])
-                self(self, heavy_child[cur], cur_head);
-            for (const size_t nxt: edges[cur])
-                if (nxt != fa[cur] && nxt != heavy_child[cur])
-                    self(self, nxt, nxt);
-        };
-        dfs2(dfs2, 0uz, 0uz);
+        // 栈中存放尚未处理的轻儿子, 后进先出保证每棵子树的 dfn 连续
+        std::vector<size_t> &stack = order;
+        stack.assign(1, 0uz);
+        size_t time_stamp = 0;
+        while (!stack.empty()) {
+            const size_t cur_head = stack.back();
+            stack.pop_back();
+            for (size_t cur = cur_head; ~cur; cur = heavy_child[cur]) {
+                dfn[cur] = time_stamp++;
+                head[cur] = cur_head;
+                for (const size_t nxt: tree[cur])
+                    if (nxt != fa[cur] && nxt != heavy_child[cur])
+                        stack.push_back(nxt);
+            }
+        }
 
         for (size_t i = 0; i < _size; ++i)
             inv_dfn[dfn[i]] = i;
@@ -0,0 +1,120 @@
+#ifndef LCA_H
+#define LCA_H
+#include <cassert>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include "csr_tree.h"
+#include "union_find.h"
+#include "range_sum_container/linear_RMQ.h"
+#include "range_sum_container/wrappers.h"
+
+/**
+ * O(n) 预处理, O(1) 查询的 LCA, 输入与 HLD 相同
+ * 设 dfn[u] < dfn[v], 则 LCA(u, v) 是 dfn 落在 (dfn[u], dfn[v]] 内的点中父亲 dfn 最小者的父亲,
+ * 于是在 dfs 序上对 "父亲的 dfn" 做 RMQ 即可, 序列长 n 而非欧拉序的 2n - 1
+ */
+struct RMQ_LCA {
+    std::vector<size_t> dfn, inv_dfn;
+    linear_RMQ<min_wrapper<size_t> > rmq;
+
+    explicit RMQ_LCA(const std::vector<std::vector<size_t> > &edges, const size_t root = 0)
+        : RMQ_LCA(csr_tree(edges), root) {
+    }
+
+    explicit RMQ_LCA(const csr_tree &tree, const size_t root = 0) : dfn(tree.size()), inv_dfn(tree.size()),
+                                                                     rmq(build(tree, root)) {
+    }
+
+private:
+    // 显式栈求先序 dfn, 返回每个 dfn 位置上父亲的 dfn
+    std::vector<min_wrapper<size_t> > build(const csr_tree &tree, const size_t root) {
+        const size_t n = tree.size();
+        std::vector<min_wrapper<size_t> > parent_dfn(n);
+        if (!n)
+            return parent_dfn;
+        std::vector<std::pair<size_t, size_t> > stack{{root, ~0uz}};
+        for (size_t time_stamp = 0; !stack.empty();) {
+            const auto [cur, from] = stack.back();
+            stack.pop_back();
+            dfn[cur] = time_stamp++;
+            inv_dfn[dfn[cur]] = cur;
+            parent_dfn[dfn[cur]] = ~from ? dfn[from] : 0;
+            for (const size_t nxt: tree[cur])
+                if (nxt != from)
+                    stack.emplace_back(nxt, cur);
+        }
+        return parent_dfn;
+    }
+
+public:
+    [[nodiscard]] size_t LCA(const size_t u, const size_t v) const {
+        assert(u < dfn.size() && v < dfn.size());
+        if (u == v)
+            return u;
+        const auto [l, r] = std::minmax(dfn[u], dfn[v]);
+        return inv_dfn[rmq.query(l + 1, r + 1)];
+    }
+};
+
+/**
+ * 离线 Tarjan LCA, 一次 dfs 回答所有询问, O((n + q) α(n))
+ * 返回值按询问顺序排列
+ */
+inline std::vector<size_t> tarjan_LCA(const csr_tree &tree, const std::vector<std::pair<size_t, size_t> > &queries,
+                                      const size_t root = 0) {
+    const size_t n = tree.size();
+    std::vector<size_t> ans(queries.size());
+    if (!n)
+        return ans;
+
+    // 询问也按 CSR 挂在两个端点上
+    std::vector<size_t> q_offset(n + 1), q_idx(queries.size() * 2);
+    for (const auto &[u, v]: queries) {
+        assert(u < n && v < n);
+        ++q_offset[u + 1];
+        ++q_offset[v + 1];
+    }
+    std::partial_sum(q_offset.begin(), q_offset.end(), q_offset.begin());
+    std::vector<size_t> fill(q_offset.begin(), q_offset.end() - 1);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        q_idx[fill[queries[i].first]++] = i;
+        q_idx[fill[queries[i].second]++] = i;
+    }
+
+    union_find uf(n);
+    std::vector<size_t> anc(n), fa(n, ~0uz), cursor(n);
+    std::iota(anc.begin(), anc.end(), 0uz);
+    std::vector<bool> finished(n);
+    std::vector<size_t> stack{root};
+    while (!stack.empty()) {
+        const size_t cur = stack.back();
+        if (const auto adj = tree[cur]; cursor[cur] < adj.size()) {
+            if (const size_t nxt = adj[cursor[cur]++]; nxt != fa[cur]) {
+                fa[nxt] = cur;
+                stack.push_back(nxt);
+            }
+            continue;
+        }
+
+        stack.pop_back();
+        finished[cur] = true;
+        for (size_t i = q_offset[cur]; i < q_offset[cur + 1]; ++i) {
+            const auto [u, v] = queries[q_idx[i]];
+            if (const size_t other = u == cur ? v : u; finished[other])
+                ans[q_idx[i]] = anc[uf.root(other)];
+        }
+        if (~fa[cur]) {
+            uf.link(cur, fa[cur]);
+            anc[uf.root(fa[cur])] = fa[cur];
+        }
+    }
+    return ans;
+}
+
+inline std::vector<size_t> tarjan_LCA(const std::vector<std::vector<size_t> > &edges,
+                                      const std::vector<std::pair<size_t, size_t> > &queries, const size_t root = 0) {
+    return tarjan_LCA(csr_tree(edges), queries, root);
+}
+
+#endif //LCA_H
@@ -0,0 +1,69 @@
+#ifndef CONCURRENT_UNION_FIND_H
+#define CONCURRENT_UNION_FIND_H
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+/**
+ * 无锁并查集, link, root, is_linked 均可多线程同时调用
+ * 父指针用 CAS 修改: 根只会被挂到优先级更高的根下且只会被挂一次, 因此不会成环;
+ * 优先级是下标经过固定双射打乱后的值, 相当于随机化的按秩合并, 查找时做路径减半
+ */
+struct concurrent_union_find {
+    std::vector<std::atomic<size_t> > par;
+
+    explicit concurrent_union_find(const size_t n): par(n) {
+        for (size_t i = 0; i < n; ++i)
+            par[i].store(i, std::memory_order_relaxed);
+    }
+
+    static constexpr size_t priority(size_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdull;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ull;
+        x ^= x >> 33;
+        return x;
+    }
+
+    size_t root(size_t x) {
+        while (true) {
+            size_t p = par[x].load(std::memory_order_acquire);
+            if (p == x)
+                return x;
+            const size_t gp = par[p].load(std::memory_order_acquire);
+            if (p != gp)
+                par[x].compare_exchange_weak(p, gp, std::memory_order_release, std::memory_order_relaxed);
+            x = gp;
+        }
+    }
+
+    bool link(size_t x, size_t y) {
+        while (true) {
+            x = root(x);
+            y = root(y);
+            if (x == y)
+                return false;
+            if (priority(x) > priority(y))
+                std::swap(x, y);
+            size_t expected = x;
+            if (par[x].compare_exchange_strong(expected, y, std::memory_order_acq_rel, std::memory_order_acquire))
+                return true;
+        }
+    }
+
+    bool is_linked(size_t x, size_t y) {
+        while (true) {
+            x = root(x);
+            y = root(y);
+            if (x == y)
+                return true;
+            // x 在求出 y 的根之后仍是根, 则求 y 的根的那一刻二者不连通
+            if (par[x].load(std::memory_order_acquire) == x)
+                return false;
+        }
+    }
+};
+
+#endif //CONCURRENT_UNION_FIND_H
@@ -0,0 +1,51 @@
+#ifndef CSR_TREE_H
+#define CSR_TREE_H
+
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+ * 压缩稀疏行 (CSR) 存储的邻接表, 所有邻居连续存放, 点 u 的邻居为 adj[offset[u], offset[u + 1])
+ * 相比 std::vector<std::vector<size_t> > 只有两次分配, 遍历时不再逐点跳指针
+ */
+struct csr_tree {
+    std::vector<size_t> offset, adj;
+
+    csr_tree(): offset(1) {
+    }
+
+    explicit csr_tree(const std::vector<std::vector<size_t> > &edges): offset(edges.size() + 1) {
+        for (size_t u = 0; u < edges.size(); ++u)
+            offset[u + 1] = offset[u] + edges[u].size();
+        adj.reserve(offset.back());
+        for (const auto &e: edges)
+            adj.insert(adj.end(), e.begin(), e.end());
+    }
+
+    // n 个点的无向边表
+    explicit csr_tree(const size_t n, const std::vector<std::pair<size_t, size_t> > &edges): offset(n + 2) {
+        for (const auto &[u, v]: edges) {
+            ++offset[u + 2];
+            ++offset[v + 2];
+        }
+        for (size_t u = 2; u < offset.size(); ++u)
+            offset[u] += offset[u - 1];
+        adj.resize(edges.size() * 2);
+        for (const auto &[u, v]: edges) {
+            adj[offset[u + 1]++] = v;
+            adj[offset[v + 1]++] = u;
+        }
+        offset.pop_back();
+    }
+
+    [[nodiscard]] size_t size() const {
+        return offset.size() - 1;
+    }
+
+    std::span<const size_t> operator[](const size_t u) const {
+        return {adj.data() + offset[u], adj.data() + offset[u + 1]};
+    }
+};
+
+#endif //CSR_TREE_H
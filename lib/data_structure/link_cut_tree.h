@@ -0,0 +1,206 @@
+#ifndef LINK_CUT_TREE_H
+#define LINK_CUT_TREE_H
+#include <array>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../concepts/algebra_concepts.h"
+#include "range_sum_container/wrappers.h"
+
+/**
+ * Link-cut tree, 维护动态森林上的路径和, 标记与数据的代数结构同 zkw_seg_tree
+ * 结点存于若干连续数组中, 0 号为空结点, 外部编号 i 对应内部 i + 1; splay 非递归
+ * 换根需要翻转路径, 因此结点同时存正向与反向的和; 若 is_commutative_v<G> 为真则只存 G 本身
+ */
+template<typename T, typename G>
+    requires requires(T t1, T t2, G g1, G g2)
+    {
+        { t1 * t2 } -> std::convertible_to<T>;
+        { g1 + g2 } -> std::convertible_to<G>;
+        { t1 * g2 } -> std::convertible_to<G>;
+    }
+struct link_cut_tree {
+    using node_t = std::conditional_t<is_commutative_v<G>, G, bidirectional_wrapper<G> >;
+
+private:
+    std::vector<std::array<size_t, 2> > ch;
+    std::vector<size_t> fa;
+    std::vector<G> val;
+    std::vector<node_t> sum;
+    std::vector<T> tag;
+    std::vector<char> rev;
+    std::vector<size_t> stack;
+
+    [[nodiscard]] bool is_root(const size_t x) const {
+        const size_t f = fa[x];
+        return !f || (ch[f][0] != x && ch[f][1] != x);
+    }
+
+    void reverse(const size_t x) {
+        std::swap(ch[x][0], ch[x][1]);
+        if constexpr (!is_commutative_v<G>)
+            std::swap(sum[x].forward, sum[x].backward);
+        rev[x] ^= 1;
+    }
+
+    void update(const size_t x, const T &ntag) {
+        val[x] = ntag * val[x];
+        sum[x] = ntag * sum[x];
+        tag[x] = ntag * tag[x];
+    }
+
+    void push_up(const size_t x) {
+        node_t s = ch[x][0] ? sum[ch[x][0]] : node_t{};
+        s = s + node_t(val[x]);
+        if (ch[x][1])
+            s = s + sum[ch[x][1]];
+        sum[x] = std::move(s);
+    }
+
+    void push_down(const size_t x) {
+        for (const size_t c: ch[x]) {
+            if (c) {
+                if (rev[x])
+                    reverse(c);
+                update(c, tag[x]);
+            }
+        }
+        rev[x] = 0;
+        tag[x] = T{};
+    }
+
+    void rotate(const size_t x) {
+        const size_t y = fa[x], z = fa[y];
+        const bool k = ch[y][1] == x;
+        if (!is_root(y))
+            ch[z][ch[z][1] == y] = x;
+        fa[x] = z;
+        ch[y][k] = ch[x][!k];
+        if (ch[x][!k])
+            fa[ch[x][!k]] = y;
+        ch[x][!k] = y;
+        fa[y] = x;
+        push_up(y);
+        push_up(x);
+    }
+
+    void splay(const size_t x) {
+        stack.assign(1, x);
+        for (size_t y = x; !is_root(y); y = fa[y])
+            stack.push_back(fa[y]);
+        for (; !stack.empty(); stack.pop_back())
+            push_down(stack.back());
+
+        while (!is_root(x)) {
+            const size_t y = fa[x];
+            if (!is_root(y))
+                rotate((ch[y][1] == x) == (ch[fa[y]][1] == y) ? y : x);
+            rotate(x);
+        }
+    }
+
+    void access(size_t x) {
+        for (size_t y = 0; x; y = x, x = fa[x]) {
+            splay(x);
+            ch[x][1] = y;
+            push_up(x);
+        }
+    }
+
+    void make_root(const size_t x) {
+        access(x);
+        splay(x);
+        reverse(x);
+    }
+
+    size_t find_root(size_t x) {
+        access(x);
+        splay(x);
+        while (ch[x][0]) {
+            push_down(x);
+            x = ch[x][0];
+        }
+        splay(x);
+        return x;
+    }
+
+    // 把 u 到 v 的路径拉成以 v 为根的一棵 splay, 要求 u, v 连通
+    size_t split(const size_t u, const size_t v) {
+        make_root(u + 1);
+        access(v + 1);
+        splay(v + 1);
+        return v + 1;
+    }
+
+    static const G &forward(const node_t &x) {
+        if constexpr (is_commutative_v<G>)
+            return x;
+        else
+            return x.forward;
+    }
+
+public:
+    explicit link_cut_tree(const size_t n) : link_cut_tree(std::vector<G>(n)) {
+    }
+
+    explicit link_cut_tree(std::vector<G> data) : ch(data.size() + 1), fa(data.size() + 1), val(data.size() + 1),
+                                                  sum(data.size() + 1), tag(data.size() + 1), rev(data.size() + 1) {
+        for (size_t i = 0; i < data.size(); ++i) {
+            sum[i + 1] = node_t(data[i]);
+            val[i + 1] = std::move(data[i]);
+        }
+    }
+
+    [[nodiscard]] size_t size() const {
+        return val.size() - 1;
+    }
+
+    bool is_linked(const size_t u, const size_t v) {
+        return find_root(u + 1) == find_root(v + 1);
+    }
+
+    // 加边 (u, v), 已连通时返回 false
+    bool link(const size_t u, const size_t v) {
+        make_root(u + 1);
+        if (find_root(v + 1) == u + 1)
+            return false;
+        fa[u + 1] = v + 1;
+        return true;
+    }
+
+    // 删边 (u, v), 边不存在时返回 false
+    bool cut(const size_t u, const size_t v) {
+        const size_t x = u + 1, y = v + 1;
+        make_root(x);
+        if (find_root(y) != x || fa[y] != x || ch[y][0])
+            return false;
+        fa[y] = ch[x][1] = 0;
+        push_up(x);
+        return true;
+    }
+
+    // 按 u -> v 的顺序求路径和, 要求 u, v 连通
+    G query(const size_t u, const size_t v) {
+        return forward(sum[split(u, v)]);
+    }
+
+    // 路径上每个点打上标记 ntag, 要求 u, v 连通
+    void modify(const size_t u, const size_t v, const T &ntag) {
+        update(split(u, v), ntag);
+    }
+
+    G get(const size_t u) {
+        access(u + 1);
+        splay(u + 1);
+        return val[u + 1];
+    }
+
+    void set(const size_t u, G g) {
+        access(u + 1);
+        splay(u + 1);
+        val[u + 1] = std::move(g);
+        push_up(u + 1);
+    }
+};
+
+#endif //LINK_CUT_TREE_H
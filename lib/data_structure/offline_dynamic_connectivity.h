@@ -0,0 +1,108 @@
+#ifndef OFFLINE_DYNAMIC_CONNECTIVITY_H
+#define OFFLINE_DYNAMIC_CONNECTIVITY_H
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <map>
+#include <numeric>
+#include <vector>
+#include "rollback_union_find.h"
+
+/**
+ * 离线动态图连通性 (线段树分治)
+ * 依次记录加边, 删边和询问, 每条边在询问时间轴上存活一段区间, 按 zkw 线段树的方式拆到 O(log q) 个结点上,
+ * 最后 dfs 整棵树, 进入结点时 link 其上的边, 离开时 rollback
+ */
+struct offline_dynamic_connectivity {
+    struct edge_interval {
+        size_t u, v, b, e;
+    };
+
+    size_t n;
+    std::map<std::pair<size_t, size_t>, std::vector<size_t> > alive;
+    std::vector<edge_interval> intervals;
+    std::vector<std::pair<size_t, size_t> > queries;
+
+    explicit offline_dynamic_connectivity(const size_t n): n(n) {
+    }
+
+    void link(size_t u, size_t v) {
+        assert(u < n && v < n);
+        if (u > v)
+            std::swap(u, v);
+        alive[{u, v}].push_back(queries.size());
+    }
+
+    // (u, v) 必须是当前存在的边, 重边每次删去一条
+    void cut(size_t u, size_t v) {
+        assert(u < n && v < n);
+        if (u > v)
+            std::swap(u, v);
+        const auto it = alive.find({u, v});
+        assert(it != alive.end());
+        intervals.push_back({u, v, it->second.back(), queries.size()});
+        it->second.pop_back();
+        if (it->second.empty())
+            alive.erase(it);
+    }
+
+    // 记录一次询问, 返回其编号
+    size_t query(const size_t u, const size_t v) {
+        assert(u < n && v < n);
+        queries.emplace_back(u, v);
+        return queries.size() - 1;
+    }
+
+    // 按编号返回每次询问时 u, v 是否连通
+    std::vector<bool> solve() {
+        const size_t q = queries.size();
+        std::vector<bool> ans(q);
+        if (!q)
+            return ans;
+
+        for (const auto &[e, starts]: alive)
+            for (const size_t b: starts)
+                intervals.push_back({e.first, e.second, b, q});
+        alive.clear();
+
+        const size_t _size = std::bit_ceil(q);
+        auto decompose = [&](const edge_interval &it, auto &&f) {
+            for (size_t l = it.b + _size, r = it.e + _size; l < r; l >>= 1, r >>= 1) {
+                if (l & 1)
+                    f(l++);
+                if (r & 1)
+                    f(--r);
+            }
+        };
+
+        // 每个结点上的边连续存放在 [offset[p], offset[p + 1])
+        std::vector<size_t> offset((_size << 1) + 1);
+        for (const auto &it: intervals)
+            decompose(it, [&](const size_t p) { ++offset[p + 1]; });
+        std::partial_sum(offset.begin(), offset.end(), offset.begin());
+        std::vector<std::pair<size_t, size_t> > edges(offset.back());
+        std::vector<size_t> fill(offset.begin(), offset.end() - 1);
+        for (const auto &it: intervals)
+            decompose(it, [&](const size_t p) { edges[fill[p]++] = {it.u, it.v}; });
+
+        rollback_union_find uf(n);
+        auto dfs = [&](auto &&self, const size_t p) -> void {
+            const size_t snap = uf.snapshot();
+            for (size_t i = offset[p]; i < offset[p + 1]; ++i)
+                uf.link(edges[i].first, edges[i].second);
+            if (p >= _size) {
+                if (p - _size < q)
+                    ans[p - _size] = uf.is_linked(queries[p - _size].first, queries[p - _size].second);
+            } else {
+                self(self, p << 1);
+                self(self, p << 1 | 1);
+            }
+            uf.rollback(snap);
+        };
+        dfs(dfs, 1);
+        return ans;
+    }
+};
+
+#endif //OFFLINE_DYNAMIC_CONNECTIVITY_H
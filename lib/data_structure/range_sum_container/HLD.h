@@ -1,10 +1,17 @@
-#ifndef HLD_H
-#define HLD_H
+#ifndef FORWARD_HLD_H
+#define FORWARD_HLD_H
 #include <stdexcept>
 #include <vector>
-#include <ranges>
+#include <type_traits>
+#include "../HLD.h"
+#include "../../concepts/algebra_concepts.h"
+#include "wrappers.h"
 #include "zkw_seg_tree.h"
 
+/**
+ * 路径按 u -> v 的顺序求和的树剖, 只用一棵线段树
+ * 每个结点同时存正向与反向的和 (bidirectional_wrapper); 若 is_commutative_v<G> 为真则只存 G 本身
+ */
 template<typename T, typename G>
     requires requires(T t1, T t2, G g1, G g2)
     {
@@ -13,102 +20,85 @@ template<typename T, typename G>
         { t1 * g2 } -> std::convertible_to<G>;
     }
 struct forward_HLD {
-    std::vector<std::vector<size_t> > edges;
-    size_t _size;
-    std::vector<size_t> depth, fa, size, heavy_child;
-    std::vector<size_t> head, dfn;
-    zkw_seg_tree<T, G> _seg_tree, backward_seg_tree;
+    using node_t = std::conditional_t<is_commutative_v<G>, G, bidirectional_wrapper<G> >;
 
-    explicit forward_HLD(std::vector<std::vector<size_t> > edges_, std::vector<G> data) : edges(std::move(edges_)),
-        _size(edges.size()), depth(_size), fa(_size), size(_size, 1uz), heavy_child(_size, ~0uz), head(_size),
-        dfn(_size), _seg_tree(0uz), backward_seg_tree(0uz) {
-        auto dfs1 = [&](auto &&self, const size_t cur, const size_t from) -> void {
-            depth[cur] = ~from ? depth[from] + 1 : 0;
-            fa[cur] = ~from ? from : ~0uz;
-            for (const size_t nxt: edges[cur]) {
-                if (nxt != from) {
-                    self(self, nxt, cur);
-                    size[cur] += size[nxt];
-                    if (!~heavy_child[cur] || size[nxt] > size[heavy_child[cur]])
-                        heavy_child[cur] = nxt;
-                }
-            }
-        };
-        dfs1(dfs1, 0uz, ~0uz);
+    HLD hld;
+    zkw_seg_tree<T, node_t> _seg_tree;
+
+    explicit forward_HLD(const std::vector<std::vector<size_t> > &edges, std::vector<G> data)
+        : forward_HLD(csr_tree(edges), std::move(data)) {
+    }
 
-        auto dfs2 = [&, time_stamp = 0uz](auto &&self, const size_t cur, const size_t cur_head) mutable -> void {
-            dfn[cur] = time_stamp++;
-            head[cur] = cur_head;
-            if (~heavy_child[cur])
-                self(self, heavy_child[cur], cur_head);
-            for (const size_t nxt: edges[cur])
-                if (nxt != fa[cur] && nxt != heavy_child[cur])
-                    self(self, nxt, nxt);
-        };
-        dfs2(dfs2, 0uz, 0uz);
+    explicit forward_HLD(csr_tree tree, std::vector<G> data) : hld(std::move(tree)), _seg_tree(0uz) {
+        std::vector<node_t> transformed_data(hld._size);
+        for (size_t i = 0; i < hld._size; ++i)
+            transformed_data[hld.dfn[i]] = node_t(std::move(data[i]));
 
-        std::vector<G> transformed_data(_size);
-        for (size_t i = 0; i < _size; ++i)
-            transformed_data[dfn[i]] = std::move(data[i]);
+        _seg_tree = zkw_seg_tree<T, node_t>(transformed_data);
+    }
 
-        _seg_tree = zkw_seg_tree<T, G>(transformed_data);
-        backward_seg_tree = zkw_seg_tree<T, G>(transformed_data | std::views::reverse);
+private:
+    static G &forward(node_t &x) {
+        if constexpr (is_commutative_v<G>)
+            return x;
+        else
+            return x.forward;
     }
 
+    static const G &forward(const node_t &x) {
+        if constexpr (is_commutative_v<G>)
+            return x;
+        else
+            return x.forward;
+    }
+
+    static const G &backward(const node_t &x) {
+        if constexpr (is_commutative_v<G>)
+            return x;
+        else
+            return x.backward;
+    }
+
+public:
     G seg_query(size_t u, size_t v) {
-        if (u >= _size || v >= _size)
+        if (u >= hld._size || v >= hld._size)
             throw std::range_error{""};
         G ans_u, ans_v;
-        while (head[u] != head[v]) {
-            if (depth[head[u]] > depth[head[v]]) {
-                ans_u = ans_u + backward_seg_tree.query(_size - 1 - dfn[u], _size - 1 - dfn[head[u]] + 1);
-                u = fa[head[u]];
+        while (hld.head[u] != hld.head[v]) {
+            if (hld.depth[hld.head[u]] > hld.depth[hld.head[v]]) {
+                ans_u = ans_u + backward(_seg_tree.query(hld.dfn[hld.head[u]], hld.dfn[u] + 1));
+                u = hld.fa[hld.head[u]];
             } else {
-                ans_v = _seg_tree.query(dfn[head[v]], dfn[v] + 1) + ans_v;
-                v = fa[head[v]];
+                ans_v = forward(_seg_tree.query(hld.dfn[hld.head[v]], hld.dfn[v] + 1)) + ans_v;
+                v = hld.fa[hld.head[v]];
             }
         }
-        const G ans_mid = depth[u] < depth[v]
-                              ? _seg_tree.query(dfn[u], dfn[v] + 1)
-                              : backward_seg_tree.query(_size - 1 - dfn[u], _size - 1 - dfn[v] + 1);
+        const G ans_mid = hld.depth[u] < hld.depth[v]
+                              ? forward(_seg_tree.query(hld.dfn[u], hld.dfn[v] + 1))
+                              : backward(_seg_tree.query(hld.dfn[v], hld.dfn[u] + 1));
         return ans_u + ans_mid + ans_v;
     }
 
-    void seg_modify(size_t u, size_t v, const T &ntag) {
-        if (u >= _size || v >= _size)
+    void seg_modify(const size_t u, const size_t v, const T &ntag) {
+        if (u >= hld._size || v >= hld._size)
             throw std::range_error{""};
-        while (head[u] != head[v]) {
-            if (depth[head[u]] > depth[head[v]]) {
-                _seg_tree.modify(dfn[head[u]], dfn[u] + 1, ntag);
-                backward_seg_tree.modify(_size - 1 - dfn[u], _size - 1 - dfn[head[u]] + 1, ntag);
-                u = fa[head[u]];
-            } else {
-                _seg_tree.modify(dfn[head[v]], dfn[v] + 1, ntag);
-                backward_seg_tree.modify(_size - 1 - dfn[v], _size - 1 - dfn[head[v]] + 1, ntag);
-                v = fa[head[v]];
-            }
-        }
-
-        const size_t dfn_min = std::min(dfn[u], dfn[v]);
-        const size_t dfn_max = std::max(dfn[u], dfn[v]);
-
-        _seg_tree.modify(dfn_min, dfn_max + 1, ntag);
-        backward_seg_tree.modify(_size - 1 - dfn_max, _size - 1 - dfn_min + 1, ntag);
+        hld.seg_perform(u, v, [&](const size_t s, const size_t t) {
+            _seg_tree.modify(s, t, ntag);
+        });
     }
 
     // untested!!
     void resolve_all_tags() {
         _seg_tree.resolve_all_tags();
-        backward_seg_tree.resolve_all_tags();
     }
 
     G &get_unchecked(const size_t idx) {
-        return _seg_tree.get_unchecked(dfn[idx]);
+        return forward(_seg_tree.get_unchecked(hld.dfn[idx]));
     }
 
     const G &get_unchecked(const size_t idx) const {
-        return _seg_tree.get_unchecked(dfn[idx]);
+        return forward(_seg_tree.get_unchecked(hld.dfn[idx]));
     }
 };
 
-#endif //HLD_H
+#endif //FORWARD_HLD_H
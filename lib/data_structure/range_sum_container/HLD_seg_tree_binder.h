@@ -3,6 +3,7 @@
 #include <vector>
 #include <ranges>
 #include <algorithm>
+#include <bit>
 #include "../HLD.h"
 #include "zkw_seg_tree.h"
 
@@ -13,13 +14,15 @@ template<typename T, typename G>
         { g1 + g2 } -> std::convertible_to<G>;
         { t1 * g2 } -> std::convertible_to<G>;
     }
-struct forward_HLD {
+struct HLD_binder {
     HLD hld;
     zkw_seg_tree<T, G> _seg_tree;
 
-    explicit forward_HLD(std::vector<std::vector<size_t> > edges, std::vector<G> data) : hld(std::move(edges)),
-        _seg_tree(0uz) {
+    explicit HLD_binder(const std::vector<std::vector<size_t> > &edges, std::vector<G> data)
+        : HLD_binder(csr_tree(edges), std::move(data)) {
+    }
 
+    explicit HLD_binder(csr_tree tree, std::vector<G> data) : hld(std::move(tree)), _seg_tree(0uz) {
         std::vector<G> transformed_data(hld._size);
         for (size_t i = 0; i < hld._size; ++i)
             transformed_data[hld.dfn[i]] = std::move(data[i]);
@@ -46,6 +49,40 @@ struct forward_HLD {
         });
     }
 
+    /**
+     * 批量路径查询, 返回值与逐个调用 seg_query 相同
+     * 区间总数 k 满足 k log n > n 时, 先一次性下放全部标记 (O(n)), 再对每个区间分别做 O(log n) 的只读查询,
+     * 省掉的只是每次查询的 push_down, 区间之间不排序也不合并; 否则逐个区间调用 query, 不为小批量付出 O(n)
+     */
+    std::vector<G> seg_query(const std::vector<std::pair<size_t, size_t> > &paths) {
+        std::vector<std::pair<size_t, size_t> > pieces;
+        std::vector<size_t> path_offset{0};
+        path_offset.reserve(paths.size() + 1);
+        for (const auto &[u, v]: paths) {
+            assert(u < hld._size && v < hld._size);
+            hld.seg_perform(u, v, [&] (const size_t s, const size_t t) {
+                pieces.emplace_back(s, t);
+            });
+            path_offset.push_back(pieces.size());
+        }
+
+        std::vector<G> piece_ans(pieces.size());
+        if (pieces.size() * std::bit_width(hld._size) > hld._size) {
+            _seg_tree.resolve_all_tags();
+            for (size_t i = 0; i < pieces.size(); ++i)
+                piece_ans[i] = _seg_tree.query_unchecked(pieces[i].first, pieces[i].second);
+        } else {
+            for (size_t i = 0; i < pieces.size(); ++i)
+                piece_ans[i] = _seg_tree.query(pieces[i].first, pieces[i].second);
+        }
+
+        std::vector<G> ans(paths.size());
+        for (size_t i = 0; i < paths.size(); ++i)
+            for (size_t j = path_offset[i]; j < path_offset[i + 1]; ++j)
+                ans[i] = ans[i] + piece_ans[j];
+        return ans;
+    }
+
     G subtree_query(const size_t idx) {
         assert(idx < hld._size);
 
@@ -60,12 +97,11 @@ struct forward_HLD {
     void subtree_modify(const size_t idx, const T &ntag) {
         assert(idx < hld._size);
 
-        hld.seg_perform(idx, [&] (const size_t s, const size_t t) {
+        hld.subtree_perform(idx, [&] (const size_t s, const size_t t) {
             _seg_tree.modify(s, t, ntag);
         });
     }
 
-    // untested!!
     void resolve_all_tags() {
         _seg_tree.resolve_all_tags();
     }
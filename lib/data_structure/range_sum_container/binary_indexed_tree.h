@@ -1,5 +1,6 @@
 #ifndef BINARY_INDEXED_TREE_H
 #define BINARY_INDEXED_TREE_H
+#include <bit>
 #include <numeric>
 #include <vector>
 
@@ -95,6 +96,28 @@ struct binary_indexed_tree {
     constexpr T query(const size_t b, const size_t e) const {
         return sum(e) - (b ? sum(b - 1) : T{});
     }
+
+    /**
+     * pred 在前缀和上单调 (先真后假), 返回第一个使 pred(sum(idx)) 为假的 idx, 不存在则返回 size()
+     * 自顶向下倍增, 复杂度 O(log n)
+     */
+    template<std::predicate<const T &> P>
+    [[nodiscard]] constexpr size_t partition_point(P pred) const {
+        size_t pos = 0;
+        T acc{};
+        for (size_t step = std::bit_floor(data.size()); step; step >>= 1) {
+            if (pos + step <= data.size() && pred(acc + data[pos + step - 1])) {
+                pos += step;
+                acc += data[pos - 1];
+            }
+        }
+        return pos;
+    }
+
+    // 元素非负时, 第一个满足 sum(idx) >= val 的 idx
+    [[nodiscard]] constexpr size_t lower_bound(const T &val) const {
+        return partition_point([&val](const T &s) { return s < val; });
+    }
 };
 
 #endif //BINARY_INDEXED_TREE_H
@@ -0,0 +1,126 @@
+#ifndef BLOCKED_BIT_H
+#define BLOCKED_BIT_H
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <vector>
+#include "binary_indexed_tree.h"
+
+/**
+ * 与 binary_indexed_tree 接口相同的 B 叉前缀和树, 每层按 B 个一块, 块对齐到缓存行
+ * 第 0 层存元素的块内前缀和 (含自身), 第 h 层把第 h - 1 层的每块看成一个单元, 存单元的块内前缀和 (不含自身)
+ * sum 每层只读一个数, 共 log_B n 次互不依赖的访存; add 每层给一块的后缀加上 delta,
+ * 整数类型且块的字节数为 2 的幂时, 用向量扩展加上掩码表中截出的后缀掩码, 整块一次处理
+ * 默认 B 使一块恰为一个缓存行; int32 时 B = 16, 一块是一条 AVX-512 / 两条 AVX2 / 四条 SSE2 指令,
+ * 只有 SSE2 时 add 的指令数多于 binary_indexed_tree, 编译时应打开目标机器的向量指令集 (如 -march=native)
+ */
+template<typename T, size_t B = std::max(64 / sizeof(T), 2uz)>
+    requires requires(T t)
+    {
+        { t + t } -> std::same_as<T>;
+        { t += t } -> std::same_as<T &>;
+        { t - t } -> std::same_as<T>;
+    } && (B > 1)
+struct blocked_BIT {
+    struct alignas(std::max(std::min(std::bit_ceil(sizeof(T) * B), 64uz), alignof(T))) block {
+        std::array<T, B> v{};
+    };
+
+    size_t _size;
+    // 第 h 层的块为 data[level[h], level[h + 1])
+    std::vector<size_t> level;
+    std::vector<block> data;
+
+    constexpr blocked_BIT() : blocked_BIT(0) {
+    }
+
+    explicit constexpr blocked_BIT(const size_t n) : _size(n), level{0} {
+        for (size_t units = n;;) {
+            const size_t blocks = (units + B - 1) / B;
+            level.push_back(level.back() + blocks);
+            if (blocks <= 1)
+                break;
+            units = blocks;
+        }
+        data.resize(level.back());
+    }
+
+    //input origin array in O(n)
+    template<std::ranges::input_range R>
+        requires std::is_same_v<std::ranges::range_value_t<R>, T> && std::ranges::sized_range<R>
+    explicit constexpr blocked_BIT(const R &v, from_origin_t): blocked_BIT(v.size()) {
+        std::vector<T> cur(std::ranges::begin(v), std::ranges::end(v)), next;
+        for (size_t h = 0; h + 1 < level.size(); ++h) {
+            next.assign((cur.size() + B - 1) / B, T{});
+            for (size_t j = 0; j < cur.size(); ++j) {
+                T &x = at(h, j);
+                if (h)
+                    x = next[j / B];
+                next[j / B] += cur[j];
+                if (!h)
+                    x = next[j / B];
+            }
+            cur.swap(next);
+        }
+    }
+
+    [[nodiscard]] constexpr T &at(const size_t h, const size_t j) {
+        return data[level[h] + j / B].v[j % B];
+    }
+
+    [[nodiscard]] constexpr const T &at(const size_t h, const size_t j) const {
+        return data[level[h] + j / B].v[j % B];
+    }
+
+    // 整数类型时 suffix_mask[B - from + k] 在 k >= from 时全为 1, 否则为 0
+    static constexpr std::array<T, 2 * B> suffix_mask = [] {
+        std::array<T, 2 * B> m{};
+        if constexpr (std::integral<T>)
+            std::fill(m.begin() + B, m.end(), static_cast<T>(~T{}));
+        return m;
+    }();
+
+    // blk 中下标不小于 from (<= B) 的位置加上 delta
+    static constexpr void add_suffix(block &blk, const size_t from, const T &delta) {
+        if constexpr (std::integral<T> && std::has_single_bit(sizeof(T) * B)) {
+            if !consteval {
+                // 整块作为一个向量, 编译器按目标机器的向量宽度展开, 无分支
+                typedef T vec_t __attribute__((vector_size(sizeof(T) * B)));
+                vec_t x, m;
+                std::memcpy(&x, blk.v.data(), sizeof x);
+                std::memcpy(&m, suffix_mask.data() + B - from, sizeof m);
+                x += m & delta;
+                std::memcpy(blk.v.data(), &x, sizeof x);
+                return;
+            }
+        }
+        for (size_t k = from; k < B; ++k)
+            blk.v[k] += delta;
+    }
+
+    constexpr size_t size() const {
+        return _size;
+    }
+
+    constexpr void add(size_t idx, const T &delta) {
+        add_suffix(data[idx / B], idx % B, delta);
+        for (size_t h = 1; h + 1 < level.size(); ++h) {
+            idx /= B;
+            add_suffix(data[level[h] + idx / B], idx % B + 1, delta);
+        }
+    }
+
+    [[nodiscard]] constexpr T sum(size_t idx) const {
+        T ans = at(0, idx);
+        for (size_t h = 1; h + 1 < level.size(); ++h)
+            ans += at(h, idx /= B);
+        return ans;
+    }
+
+    constexpr T query(const size_t b, const size_t e) const {
+        return sum(e) - (b ? sum(b - 1) : T{});
+    }
+};
+
+#endif //BLOCKED_BIT_H
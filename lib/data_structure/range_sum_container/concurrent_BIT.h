@@ -0,0 +1,84 @@
+#ifndef CONCURRENT_BIT_H
+#define CONCURRENT_BIT_H
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "../../parallel.h"
+
+/**
+ * 可多线程同时 add 的树状数组, 结点上用 relaxed 原子加, 不加锁
+ * 与 add 并发的 sum 只保证读到每个结点某一时刻的值, 所有写线程结束 (join) 后结果精确
+ */
+template<typename T>
+    requires std::integral<T> || std::floating_point<T>
+struct concurrent_BIT {
+    std::vector<std::atomic<T> > data;
+
+    explicit concurrent_BIT(const size_t n): data(n) {
+    }
+
+    size_t size() const {
+        return data.size();
+    }
+
+    void add(size_t idx, const T delta) {
+        for (; idx < data.size(); idx |= idx + 1)
+            data[idx].fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] T sum(size_t idx) const {
+        T ans{};
+        for (; ~idx; idx = (idx & idx + 1) - 1)
+            ans += data[idx].load(std::memory_order_relaxed);
+        return ans;
+    }
+
+    [[nodiscard]] T query(const size_t b, const size_t e) const {
+        return sum(e) - (b ? sum(b - 1) : T{});
+    }
+};
+
+// 每个线程第一次调用时领取一个递增编号
+inline size_t this_thread_index() {
+    static std::atomic<size_t> counter;
+    thread_local const size_t idx = counter.fetch_add(1, std::memory_order_relaxed);
+    return idx;
+}
+
+/**
+ * 分片版本: 每个线程固定写自己的分片, 高层结点不再被所有线程争抢同一条缓存行, 读时合并所有分片
+ * add 为 O(log n), sum 为 O(shards * log n), 适合写远多于读的计数场景
+ */
+template<typename T>
+    requires std::integral<T> || std::floating_point<T>
+struct sharded_BIT {
+    std::vector<concurrent_BIT<T> > shards;
+
+    // shard_count 为 0 时按 1 处理
+    explicit sharded_BIT(const size_t n, const size_t shard_count = default_thread_count()) {
+        shards.reserve(std::max<size_t>(shard_count, 1));
+        for (size_t i = 0; i < std::max<size_t>(shard_count, 1); ++i)
+            shards.emplace_back(n);
+    }
+
+    size_t size() const {
+        return shards.front().size();
+    }
+
+    void add(const size_t idx, const T delta) {
+        shards[this_thread_index() % shards.size()].add(idx, delta);
+    }
+
+    [[nodiscard]] T sum(const size_t idx) const {
+        T ans{};
+        for (const auto &shard: shards)
+            ans += shard.sum(idx);
+        return ans;
+    }
+
+    [[nodiscard]] T query(const size_t b, const size_t e) const {
+        return sum(e) - (b ? sum(b - 1) : T{});
+    }
+};
+
+#endif //CONCURRENT_BIT_H
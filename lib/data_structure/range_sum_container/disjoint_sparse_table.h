@@ -0,0 +1,63 @@
+#ifndef DISJOINT_SPARSE_TABLE_H
+#define DISJOINT_SPARSE_TABLE_H
+#include <cassert>
+#include <vector>
+
+#include "../../concepts/algebra_concepts.h"
+
+/**
+ * 只要求结合律的 O(1) 区间查询 (和, 积, 矩阵乘积等)
+ * 第 k 层把序列切成长为 2^(k+1) 的块, 块内以中点为界, 左半存到中点的后缀和, 右半存从中点开始的前缀和
+ * 所有层连续存放, 第 0 段为原数组, 第 k 层的起点为 (k + 1) * _size
+ */
+template<semigroup T>
+struct disjoint_sparse_table {
+    std::vector<T> data;
+    size_t _size;
+
+    constexpr explicit disjoint_sparse_table(const size_t n)
+        : data(n * (n > 1 ? (size_t) std::bit_width(n - 1) + 1 : 1)), _size(n) {
+    }
+
+    template<std::ranges::input_range R>
+        requires std::ranges::sized_range<R>
+                 && std::indirectly_copyable<std::ranges::iterator_t<R>, typename std::vector<T>::iterator>
+    constexpr explicit disjoint_sparse_table(const R &r) : disjoint_sparse_table(r.size()) {
+        std::ranges::copy(r, data.begin());
+        for (size_t k = 0; _size > 1 && k < (size_t) std::bit_width(_size - 1); ++k)
+            build_level(k);
+    }
+
+    constexpr void build_level(const size_t k) {
+        const size_t half = 1uz << k;
+        T *const level = data.data() + (k + 1) * _size;
+        for (size_t mid = half; mid < _size; mid += half << 1) {
+            level[mid - 1] = data[mid - 1];
+            for (size_t i = mid - 1; i-- > mid - half;)
+                level[i] = data[i] + level[i + 1];
+
+            level[mid] = data[mid];
+            for (size_t i = mid + 1; i < std::min(mid + half, _size); ++i)
+                level[i] = level[i - 1] + data[i];
+        }
+    }
+
+    [[nodiscard]] constexpr size_t size() const {
+        return _size;
+    }
+
+    [[nodiscard]] constexpr T query(const size_t l, const size_t r) const {
+        assert(l < r && r <= _size);
+        if (l == r - 1)
+            return data[l];
+        const size_t k = (size_t) std::bit_width(l ^ (r - 1)) - 1;
+        const T *const level = data.data() + (k + 1) * _size;
+        return level[l] + level[r - 1];
+    }
+
+    constexpr const T &operator[](size_t idx) const {
+        return data[idx];
+    }
+};
+
+#endif //DISJOINT_SPARSE_TABLE_H
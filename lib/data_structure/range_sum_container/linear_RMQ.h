@@ -0,0 +1,80 @@
+#ifndef LINEAR_RMQ_H
+#define LINEAR_RMQ_H
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "sparse_table.h"
+
+/**
+ * O(n) 空间, O(1) 查询的只读 RMQ, 接口与 sparse_table 相同
+ * 按 64 个一块分块, 块间用 sparse_table 维护块内最值, 块内用单调栈的位掩码定位最值
+ * 要求 x + y 总是 x 和 y 之一 (min, max 等)
+ */
+template<semigroup T>
+    requires idempotent<T> && std::equality_comparable<T>
+struct linear_RMQ {
+    constexpr static size_t B = 64;
+
+    size_t _size;
+    std::vector<T> data;
+    // mask[i] 的第 k 位表示块内第 k 个元素在前缀 [块起点, i] 的单调栈中
+    std::vector<std::uint64_t> mask;
+    sparse_table<T> blocks;
+
+    template<std::ranges::input_range R>
+        requires std::ranges::sized_range<R>
+                 && std::indirectly_copyable<std::ranges::iterator_t<R>, typename std::vector<T>::iterator>
+    explicit linear_RMQ(const R &r) : _size(r.size()), data(r.begin(), r.end()), mask(_size),
+                                      blocks(build_blocks()) {
+    }
+
+private:
+    std::vector<T> build_blocks() {
+        std::vector<T> mins;
+        mins.reserve((_size + B - 1) / B);
+        for (size_t b = 0; b < _size; b += B) {
+            std::uint64_t stk = 0;
+            for (size_t i = b; i < std::min(b + B, _size); ++i) {
+                while (stk) {
+                    const size_t top = b + (size_t) std::bit_width(stk) - 1;
+                    if (!(data[i] + data[top] == data[i]))
+                        break;
+                    stk ^= 1ull << (top - b);
+                }
+                mask[i] = stk |= 1ull << (i - b);
+            }
+            mins.push_back(data[b + (size_t) std::countr_zero(stk)]);
+        }
+        return mins;
+    }
+
+    // 块内闭区间 [l, r]
+    [[nodiscard]] const T &in_block(const size_t l, const size_t r) const {
+        const size_t b = r - r % B;
+        return data[b + (size_t) std::countr_zero(mask[r] >> (l - b) << (l - b))];
+    }
+
+public:
+    [[nodiscard]] size_t size() const {
+        return _size;
+    }
+
+    [[nodiscard]] T query(const size_t l, const size_t r) const {
+        assert(l < r && r <= _size);
+        const size_t bl = l / B, br = (r - 1) / B;
+        if (bl == br)
+            return in_block(l, r - 1);
+        T ans = in_block(l, bl * B + B - 1);
+        if (bl + 1 < br)
+            ans = ans + blocks.query(bl + 1, br);
+        return ans + in_block(br * B, r - 1);
+    }
+
+    const T &operator[](size_t idx) const {
+        return data[idx];
+    }
+};
+
+#endif //LINEAR_RMQ_H
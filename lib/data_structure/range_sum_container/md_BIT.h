@@ -0,0 +1,155 @@
+#ifndef MD_BIT_H
+#define MD_BIT_H
+#include <array>
+#include <bit>
+#include <vector>
+
+//the default value of T should be identity element
+template<typename T, size_t D>
+    requires requires(T t)
+    {
+        { t + t } -> std::same_as<T>;
+        { t += t } -> std::same_as<T &>;
+    } && (D > 0)
+struct md_binary_indexed_tree {
+    using index_t = std::array<size_t, D>;
+
+    index_t dims{}, stride{};
+    std::vector<T> data;
+
+    constexpr md_binary_indexed_tree() = default;
+
+    explicit constexpr md_binary_indexed_tree(const index_t &dims_) : dims(dims_) {
+        size_t total = 1;
+        for (size_t k = D; k--;) {
+            stride[k] = total;
+            total *= dims[k];
+        }
+        data.resize(total);
+    }
+
+private:
+    template<size_t K>
+    constexpr void _add(const size_t base, const index_t &idx, const T &delta) {
+        for (size_t i = idx[K]; i < dims[K]; i |= i + 1) {
+            if constexpr (K + 1 == D)
+                data[base + i] += delta;
+            else
+                _add<K + 1>(base + i * stride[K], idx, delta);
+        }
+    }
+
+    template<size_t K>
+    constexpr void _sum(const size_t base, const index_t &idx, T &ans) const {
+        for (size_t i = idx[K]; ~i; i = (i & i + 1) - 1) {
+            if constexpr (K + 1 == D)
+                ans += data[base + i];
+            else
+                _sum<K + 1>(base + i * stride[K], idx, ans);
+        }
+    }
+
+public:
+    constexpr const index_t &size() const {
+        return dims;
+    }
+
+    constexpr void add(const index_t &idx, const T &delta) {
+        _add<0>(0, idx, delta);
+    }
+
+    // 前缀 [0, idx] (各维均为闭区间) 的和
+    [[nodiscard]] constexpr T sum(const index_t &idx) const {
+        T ans{};
+        _sum<0>(0, idx, ans);
+        return ans;
+    }
+};
+
+/**
+ * D 维区间加, 区间求和, RMRQ_BIT 的推广
+ * 对差分数组 d, 前缀和 S(x) = sum_{p <= x} d[p] * prod_k (x_k + 1 - p_k)
+ * 把乘积按维度子集 S 展开, 对每个子集维护一棵存 d[p] * prod_{k in S} p_k 的树, 共 2^D 棵
+ */
+template<typename T, size_t D>
+    requires requires(T t, size_t times)
+    {
+        { t + t } -> std::same_as<T>;
+        { t += t } -> std::same_as<T &>;
+        { t - t } -> std::same_as<T>;
+        { times * t } -> std::convertible_to<T>;
+    } && (D > 0)
+struct md_RMRQ_BIT {
+    using index_t = std::array<size_t, D>;
+
+    std::array<md_binary_indexed_tree<T, D>, 1uz << D> trees;
+
+    constexpr md_RMRQ_BIT() = default;
+
+    explicit constexpr md_RMRQ_BIT(const index_t &dims) {
+        for (auto &tree: trees)
+            tree = md_binary_indexed_tree<T, D>(dims);
+    }
+
+private:
+    constexpr void point_add(const index_t &p, const T &delta) {
+        for (size_t s = 0; s < trees.size(); ++s) {
+            size_t coef = 1;
+            for (size_t k = 0; k < D; ++k)
+                if (s >> k & 1)
+                    coef *= p[k];
+            trees[s].add(p, coef * delta);
+        }
+    }
+
+public:
+    constexpr const index_t &size() const {
+        return trees[0].size();
+    }
+
+    // 闭区间 [b, e] 内每个位置加 delta
+    constexpr void add(const index_t &b, const index_t &e, const T &delta) {
+        for (size_t c = 0; c < trees.size(); ++c) {
+            index_t p;
+            bool in_range = true;
+            for (size_t k = 0; k < D; ++k) {
+                p[k] = c >> k & 1 ? e[k] + 1 : b[k];
+                in_range &= p[k] < size()[k];
+            }
+            if (in_range)
+                point_add(p, std::popcount(c) & 1 ? T{} - delta : delta);
+        }
+    }
+
+    // 前缀 [0, idx] 的和
+    [[nodiscard]] constexpr T sum(const index_t &idx) const {
+        T ans{};
+        for (size_t s = 0; s < trees.size(); ++s) {
+            size_t coef = 1;
+            for (size_t k = 0; k < D; ++k)
+                if (!(s >> k & 1))
+                    coef *= idx[k] + 1;
+            const T cur = coef * trees[s].sum(idx);
+            ans = std::popcount(s) & 1 ? ans - cur : ans + cur;
+        }
+        return ans;
+    }
+
+    // 闭区间 [b, e] 的和
+    [[nodiscard]] constexpr T query(const index_t &b, const index_t &e) const {
+        T ans{};
+        for (size_t c = 0; c < trees.size(); ++c) {
+            index_t p;
+            bool in_range = true;
+            for (size_t k = 0; k < D; ++k) {
+                p[k] = c >> k & 1 ? b[k] - 1 : e[k];
+                in_range &= !(c >> k & 1) || b[k];
+            }
+            if (in_range)
+                ans = std::popcount(c) & 1 ? ans - sum(p) : ans + sum(p);
+        }
+        return ans;
+    }
+};
+
+#endif //MD_BIT_H
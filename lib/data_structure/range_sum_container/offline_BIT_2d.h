@@ -0,0 +1,177 @@
+#ifndef OFFLINE_BIT_2D_H
+#define OFFLINE_BIT_2D_H
+#include <algorithm>
+#include <array>
+#include <ranges>
+#include <utility>
+#include <vector>
+#include "../../coordinate_compress.h"
+
+/**
+ * 离线二维单点加, 矩形求和, 只为会被修改的点分配空间, 空间 O(k log k)
+ * 外层是压缩后 x 上的树状数组, 其中每个结点只保存落入该结点的点的 y 坐标 (有序), 内层是这些 y 上的树状数组
+ * 所有结点连续存放, 结点 i 占 [offset[i], offset[i + 1])
+ */
+template<typename X, typename Y, typename T>
+    requires requires(T t)
+    {
+        { t + t } -> std::same_as<T>;
+        { t += t } -> std::same_as<T &>;
+        { t - t } -> std::same_as<T>;
+    } && std::totally_ordered<X> && std::totally_ordered<Y>
+struct offline_BIT_2d {
+    std::vector<X> xs;
+    std::vector<size_t> offset;
+    std::vector<Y> ys;
+    std::vector<T> data;
+
+    // points 为之后所有 add 会用到的点
+    template<std::ranges::forward_range R>
+        requires std::same_as<std::ranges::range_value_t<R>, std::pair<X, Y> >
+    explicit offline_BIT_2d(const R &points) {
+        std::vector<size_t> rank;
+        coordinate_compress(points | std::views::keys, std::back_inserter(rank));
+        xs.resize(rank.empty() ? 0 : std::ranges::max(rank) + 1);
+        for (auto it = rank.begin(); const auto &[x, y]: points)
+            xs[*it++] = x;
+
+        std::vector<std::vector<Y> > node_ys(xs.size());
+        for (auto it = rank.begin(); const auto &[x, y]: points)
+            for (size_t i = *it++; i < xs.size(); i |= i + 1)
+                node_ys[i].push_back(y);
+
+        offset.resize(xs.size() + 1);
+        for (size_t i = 0; i < xs.size(); ++i) {
+            std::ranges::sort(node_ys[i]);
+            node_ys[i].erase(std::ranges::unique(node_ys[i]).begin(), node_ys[i].end());
+            offset[i + 1] = offset[i] + node_ys[i].size();
+        }
+        ys.reserve(offset.back());
+        for (auto &v: node_ys)
+            ys.insert(ys.end(), v.begin(), v.end());
+        data.resize(offset.back());
+    }
+
+private:
+    // x 坐标排名 < cx, y 坐标 <= y (y_strict 时为 < y) 的点权和
+    [[nodiscard]] T _sum(const size_t cx, const Y &y, const bool y_strict) const {
+        T ans{};
+        for (size_t i = cx - 1; ~i; i = (i & i + 1) - 1) {
+            const auto beg = ys.begin() + offset[i], end = ys.begin() + offset[i + 1];
+            const size_t cy = (y_strict ? std::lower_bound(beg, end, y) : std::upper_bound(beg, end, y)) - beg;
+            const T *const node = data.data() + offset[i];
+            for (size_t j = cy - 1; ~j; j = (j & j + 1) - 1)
+                ans += node[j];
+        }
+        return ans;
+    }
+
+public:
+    // (x, y) 必须是构造时给出的点之一
+    void add(const X &x, const Y &y, const T &delta) {
+        for (size_t i = std::ranges::lower_bound(xs, x) - xs.begin(); i < xs.size(); i |= i + 1) {
+            const auto beg = ys.begin() + offset[i], end = ys.begin() + offset[i + 1];
+            const size_t n = end - beg;
+            T *const node = data.data() + offset[i];
+            for (size_t j = std::lower_bound(beg, end, y) - beg; j < n; j |= j + 1)
+                node[j] += delta;
+        }
+    }
+
+    // 所有 px <= x, py <= y 的点权和
+    [[nodiscard]] T sum(const X &x, const Y &y) const {
+        return _sum(std::ranges::upper_bound(xs, x) - xs.begin(), y, false);
+    }
+
+    // 同上, x_strict / y_strict 时对应维改为 < x / < y
+    [[nodiscard]] T sum(const X &x, const Y &y, const bool x_strict, const bool y_strict) const {
+        const auto it = x_strict ? std::ranges::lower_bound(xs, x) : std::ranges::upper_bound(xs, x);
+        return _sum(it - xs.begin(), y, y_strict);
+    }
+
+    // 矩形 [x1, x2] * [y1, y2] 内的点权和
+    [[nodiscard]] T query(const X &x1, const Y &y1, const X &x2, const Y &y2) const {
+        const size_t cx1 = std::ranges::lower_bound(xs, x1) - xs.begin();
+        const size_t cx2 = std::ranges::upper_bound(xs, x2) - xs.begin();
+        return _sum(cx2, y2, false) - _sum(cx1, y2, false) - _sum(cx2, y1, true) + _sum(cx1, y1, true);
+    }
+};
+
+/**
+ * 离线二维区间加, 区间求和, 空间 O(k log k), 与 md_RMRQ_BIT 相同的 2^D 展开 (D = 2)
+ * 差分只落在每个待加矩形的 4 个角上, 因此 4 棵 offline_BIT_2d 只需为这些角分配空间, 分别存 d, d * px, d * py, d * px * py
+ * 坐标须为整数; 角 (x2 + 1, y2 + 1) 不能溢出
+ */
+template<std::integral X, std::integral Y, typename T>
+    requires requires(T t)
+    {
+        { t + t } -> std::same_as<T>;
+        { t += t } -> std::same_as<T &>;
+        { t - t } -> std::same_as<T>;
+        { t * t } -> std::convertible_to<T>;
+    } && std::constructible_from<T, X> && std::constructible_from<T, Y>
+struct offline_RMRQ_BIT_2d {
+    using tree_t = offline_BIT_2d<X, Y, T>;
+    using rect_t = std::pair<std::pair<X, Y>, std::pair<X, Y> >;
+
+    std::array<tree_t, 4> trees;
+
+private:
+    template<std::ranges::forward_range R>
+    static std::array<tree_t, 4> make_trees(const R &rects) {
+        std::vector<std::pair<X, Y> > corners;
+        for (const auto &[lo, hi]: rects) {
+            corners.emplace_back(lo.first, lo.second);
+            corners.emplace_back(hi.first + 1, lo.second);
+            corners.emplace_back(lo.first, hi.second + 1);
+            corners.emplace_back(hi.first + 1, hi.second + 1);
+        }
+        const tree_t tree(corners);
+        return {tree, tree, tree, tree};
+    }
+
+    void point_add(const X &x, const Y &y, const T &delta) {
+        trees[0].add(x, y, delta);
+        trees[1].add(x, y, static_cast<T>(x) * delta);
+        trees[2].add(x, y, static_cast<T>(y) * delta);
+        trees[3].add(x, y, static_cast<T>(x) * static_cast<T>(y) * delta);
+    }
+
+    // 所有 px <= x, py <= y (strict 时为 <) 的位置上的值之和
+    // sum_{p} d[p] * (cx - px) * (cy - py), 其中 cx = x + 1 (strict 时为 x), cy 同理
+    [[nodiscard]] T _sum(const X &x, const Y &y, const bool x_strict, const bool y_strict) const {
+        const T cx = x_strict ? static_cast<T>(x) : static_cast<T>(x) + static_cast<T>(X{1});
+        const T cy = y_strict ? static_cast<T>(y) : static_cast<T>(y) + static_cast<T>(Y{1});
+        const T s0 = trees[0].sum(x, y, x_strict, y_strict), s1 = trees[1].sum(x, y, x_strict, y_strict),
+                s2 = trees[2].sum(x, y, x_strict, y_strict), s3 = trees[3].sum(x, y, x_strict, y_strict);
+        return cx * cy * s0 - cy * s1 - cx * s2 + s3;
+    }
+
+public:
+    // rects 为之后所有 add 会用到的矩形 {{x1, y1}, {x2, y2}} (闭区间)
+    template<std::ranges::forward_range R>
+        requires std::same_as<std::ranges::range_value_t<R>, rect_t>
+    explicit offline_RMRQ_BIT_2d(const R &rects) : trees(make_trees(rects)) {
+    }
+
+    // 矩形 [x1, x2] * [y1, y2] 内每个位置加 delta, 必须是构造时给出的矩形之一
+    void add(const X &x1, const Y &y1, const X &x2, const Y &y2, const T &delta) {
+        point_add(x1, y1, delta);
+        point_add(x2 + 1, y1, T{} - delta);
+        point_add(x1, y2 + 1, T{} - delta);
+        point_add(x2 + 1, y2 + 1, delta);
+    }
+
+    // 所有 px <= x, py <= y 的位置上的值之和
+    [[nodiscard]] T sum(const X &x, const Y &y) const {
+        return _sum(x, y, false, false);
+    }
+
+    // 矩形 [x1, x2] * [y1, y2] 内的和, 任意坐标均可查询
+    [[nodiscard]] T query(const X &x1, const Y &y1, const X &x2, const Y &y2) const {
+        return _sum(x2, y2, false, false) - _sum(x1, y2, true, false) - _sum(x2, y1, false, true)
+               + _sum(x1, y1, true, true);
+    }
+};
+
+#endif //OFFLINE_BIT_2D_H
@@ -3,20 +3,24 @@
 #include <cassert>
 #include <vector>
 
-#include "../../concepts/group_concepts.h"
-
-template<std::unsigned_integral T>
-T saturating_sub(const T x, const T y) {
-    return x > y ? x - y : 0;
-}
+#include "../../concepts/algebra_concepts.h"
+#include "../../math.h"
+#include "../../parallel.h"
 
 template<semigroup T>
     requires idempotent<T>
 struct sparse_table {
-    std::vector<std::vector<T> > data;
+    // 所有层连续存放, 第 i 层只存 _size - 2^i + 1 个有效位置, 起点为 offset[i]
+    // 共 L = bit_width(n) 层, 总计 L * n - 2^L + 1 + L 项, 比每层存满 n 项只少 2^L - 1 - L (< 2n) 项;
+    // 主要收益是一次分配, 各层首尾相接
+    std::vector<size_t> offset;
+    std::vector<T> data;
     size_t _size;
 
-    constexpr explicit sparse_table(const size_t n) : data((size_t) std::bit_width(n), std::vector<T>(n)), _size(n) {
+    constexpr explicit sparse_table(const size_t n) : offset((size_t) std::bit_width(n) + 1), _size(n) {
+        for (size_t i = 0; i + 1 < offset.size(); ++i)
+            offset[i + 1] = offset[i] + n - (1uz << i) + 1;
+        data.resize(offset.back());
     }
 
     template<std::ranges::input_range R>
@@ -25,14 +29,32 @@ struct sparse_table {
     constexpr explicit sparse_table(const R &r) : sparse_table(r.size()) {
         if (!r.size())
             return;
-        std::ranges::copy(r, data[0].begin());
+        std::ranges::copy(r, data.begin());
         for (size_t i = 1; i < (size_t) std::bit_width(_size); ++i)
             for (size_t j = 0; j + (1uz << i) - 1 < _size; ++j)
                 update(i, j);
     }
 
+    // 逐行建表, 第 i 行只依赖第 i - 1 行, 在行内并行
+    template<std::ranges::random_access_range R>
+        requires std::ranges::sized_range<R>
+                 && std::indirectly_copyable<std::ranges::iterator_t<R>, typename std::vector<T>::iterator>
+    explicit sparse_table(const R &r, parallel_t, const size_t threads = default_thread_count())
+        : sparse_table(r.size()) {
+        const auto beg = std::ranges::begin(r);
+        parallel_for(0uz, _size, threads, [&](const size_t b, const size_t e) {
+            std::copy(beg + b, beg + e, data.begin() + b);
+        });
+        for (size_t i = 1; i < (size_t) std::bit_width(_size); ++i)
+            parallel_for(0uz, _size - (1uz << i) + 1, threads, [&](const size_t b, const size_t e) {
+                for (size_t j = b; j < e; ++j)
+                    update(i, j);
+            });
+    }
+
     void update(const size_t i, const size_t j) {
-        data[i][j] = data[i - 1][j] + data[i - 1][j + (1uz << (i - 1))];
+        const size_t prev = offset[i - 1] + j;
+        data[offset[i] + j] = data[prev] + data[prev + (1uz << (i - 1))];
     }
 
     [[nodiscard]] constexpr size_t size() const {
@@ -42,7 +64,7 @@ struct sparse_table {
     [[nodiscard]] constexpr T query(const size_t l, const size_t r) const {
         assert(l < r && r <= _size);
         const size_t lg = (size_t) std::bit_width(r - l) - 1;
-        return data[lg][l] + data[lg][r - (1uz << lg)];
+        return data[offset[lg] + l] + data[offset[lg] + r - (1uz << lg)];
     }
 
     /**
@@ -50,18 +72,18 @@ struct sparse_table {
      * 复杂度 O(_size + (r - l) * log(_size))
      */
     constexpr void modify(const size_t l, const size_t r, const T val) {
-        std::fill(data[0].begin() + l, data[0].begin() + r, val);
+        std::fill(data.begin() + l, data.begin() + r, val);
         for (size_t i = 1; i < std::bit_width(_size); ++i)
             for (size_t j = saturating_sub(l, 1uz << i); j + (1uz << i) - 1 < _size && j < r; ++j)
                 update(i, j);
     }
 
     constexpr T operator[](size_t idx) {
-        return data[0][idx];
+        return data[idx];
     }
 
     constexpr const T &operator[](size_t idx) const {
-        return data[0][idx];
+        return data[idx];
     }
 };
 #endif //SPARSE_TABLE_H
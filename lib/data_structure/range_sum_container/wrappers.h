@@ -2,6 +2,7 @@
 #define WRAPPERS_H
 #include <algorithm>
 #include <concepts>
+#include <utility>
 template<typename T>
 concept max_able = requires(T x, T y)
 {
@@ -117,4 +118,36 @@ xor_wrapper<T> operator*(const size_t times, const xor_wrapper<T> &x) {
     return times & 1 ? x : T{};
 }
 
+// 同时维护正向与反向的和, 使不可交换的 G 也能按两个方向查询
+template<typename G>
+struct bidirectional_wrapper {
+    G forward, backward;
+
+    bidirectional_wrapper() = default;
+
+    // ReSharper disable once CppNonExplicitConvertingConstructor
+    bidirectional_wrapper(G data): forward(data), backward(std::move(data)) {
+    }
+};
+
+template<typename G>
+bidirectional_wrapper<G> operator+(const bidirectional_wrapper<G> &x, const bidirectional_wrapper<G> &y) {
+    bidirectional_wrapper<G> ans;
+    ans.forward = x.forward + y.forward;
+    ans.backward = y.backward + x.backward;
+    return ans;
+}
+
+template<typename T, typename G>
+    requires requires(T t, G g)
+    {
+        { t * g } -> std::convertible_to<G>;
+    }
+bidirectional_wrapper<G> operator*(const T &t, const bidirectional_wrapper<G> &x) {
+    bidirectional_wrapper<G> ans;
+    ans.forward = t * x.forward;
+    ans.backward = t * x.backward;
+    return ans;
+}
+
 #endif //WRAPPERS_H
@@ -2,6 +2,7 @@
 #define ZKW_SEG_TREE_H
 #include <vector>
 #include <cassert>
+#include "../../parallel.h"
 
 template<typename T, typename G>
     requires requires(T t1, T t2, G g1, G g2)
@@ -47,6 +48,23 @@ public:
             data[i] = data[i << 1] + data[i << 1 | 1];
     }
 
+    // 逐层自底向上建树, 同一层的结点互不依赖, 在层内并行
+    template<std::ranges::random_access_range R>
+        requires std::ranges::sized_range<R>
+                 && std::indirectly_copyable<std::ranges::iterator_t<R>, typename std::vector<G>::iterator>
+    explicit zkw_seg_tree(const R &r, parallel_t, const size_t threads = default_thread_count())
+        : zkw_seg_tree(r.size()) {
+        const auto beg = std::ranges::begin(r);
+        parallel_for(0uz, used_size, threads, [&](const size_t b, const size_t e) {
+            std::copy(beg + b, beg + e, data.begin() + _size + b);
+        });
+        for (size_t lv = _size >> 1; lv; lv >>= 1)
+            parallel_for(lv, lv << 1, threads, [&](const size_t b, const size_t e) {
+                for (size_t i = b; i < e; ++i)
+                    data[i] = data[i << 1] + data[i << 1 | 1];
+            });
+    }
+
     [[nodiscard]] size_t size() const { return used_size; }
 
     void modify(size_t l, size_t r, const T &ntag) {
@@ -104,7 +122,20 @@ public:
         return ansl + ansr;
     }
 
-    // untested!!
+    // 只读查询, 调用前须保证没有未下放的标记 (例如刚调用过 resolve_all_tags)
+    G query_unchecked(size_t l, size_t r) const {
+        assert(l <= r && r <= used_size);
+        G ansl, ansr;
+        for (l += _size, r += _size; l < r; l >>= 1, r >>= 1) {
+            if (l & 1)
+                ansl = ansl + data[l++];
+            if (r & 1)
+                ansr = data[--r] + ansr;
+        }
+        return ansl + ansr;
+    }
+
+    // 下放全部标记并重算内部结点, O(n); 之后可用 query_unchecked
     void resolve_all_tags() {
         for (size_t i = 1; i < _size; ++i)
             push_down(i);
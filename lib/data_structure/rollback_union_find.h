@@ -0,0 +1,64 @@
+#ifndef ROLLBACK_UNION_FIND_H
+#define ROLLBACK_UNION_FIND_H
+
+#include <utility>
+#include <vector>
+
+/**
+ * 可撤销并查集: 按大小合并, 不做路径压缩, 每次成功的 link 压入撤销栈
+ * root 为 O(log n), rollback 到任意历史快照的均摊代价与撤销的 link 次数成正比
+ */
+struct rollback_union_find {
+    // 非根结点存父亲, 根结点存 -size
+    std::vector<ptrdiff_t> par;
+    // 被挂到别处的根, 以及它挂上去之前的 -size
+    std::vector<std::pair<size_t, ptrdiff_t> > history;
+    size_t components;
+
+    explicit rollback_union_find(const size_t n): par(n, -1), components(n) {
+    }
+
+    [[nodiscard]] size_t root(size_t n) const {
+        while (par[n] >= 0)
+            n = par[n];
+        return n;
+    }
+
+    [[nodiscard]] size_t size(const size_t n) const {
+        return -par[root(n)];
+    }
+
+    bool link(const size_t x, const size_t y) {
+        size_t rx = root(x), ry = root(y);
+        if (rx == ry)
+            return false;
+        if (par[rx] < par[ry])
+            std::swap(rx, ry);
+        history.emplace_back(rx, par[rx]);
+        par[ry] += par[rx];
+        par[rx] = static_cast<ptrdiff_t>(ry);
+        --components;
+        return true;
+    }
+
+    [[nodiscard]] bool is_linked(const size_t x, const size_t y) const {
+        return root(x) == root(y);
+    }
+
+    [[nodiscard]] size_t snapshot() const {
+        return history.size();
+    }
+
+    // 撤销 snapshot() 返回 snap 之后的所有 link
+    void rollback(const size_t snap) {
+        while (history.size() > snap) {
+            const auto [rx, old] = history.back();
+            history.pop_back();
+            par[par[rx]] -= old;
+            par[rx] = old;
+            ++components;
+        }
+    }
+};
+
+#endif //ROLLBACK_UNION_FIND_H
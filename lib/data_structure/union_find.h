@@ -1,32 +1,38 @@
 #ifndef UNION_FIND_H
 #define UNION_FIND_H
 
-#include <numeric>
+#include <utility>
 #include <vector>
 
 struct union_find {
-    std::vector<size_t> par, _size;
+    // 非根结点存父亲, 根结点存 -size
+    std::vector<ptrdiff_t> par;
 
-    explicit union_find(const size_t n): par(n), _size(n, 1) {
-        std::iota(par.begin(), par.end(), 0);
+    explicit union_find(const size_t n): par(n, -1) {
     }
 
-    size_t root(const size_t n) {
-        return par[n] == n ? n : par[n] = root(par[n]);
+    // 非递归, 路径减半
+    size_t root(size_t n) {
+        while (par[n] >= 0) {
+            if (par[par[n]] >= 0)
+                par[n] = par[par[n]];
+            n = par[n];
+        }
+        return n;
     }
 
     size_t size(const size_t n) {
-        return _size[root(n)];
+        return -par[root(n)];
     }
 
     bool link(const size_t x, const size_t y) {
         size_t rx = root(x), ry = root(y);
         if (rx == ry)
             return false;
-        if (_size[rx] > _size[ry])
+        if (par[rx] < par[ry])
             std::swap(rx, ry);
-        par[rx] = ry;
-        _size[ry] += _size[rx];
+        par[ry] += par[rx];
+        par[rx] = static_cast<ptrdiff_t>(ry);
         return true;
     }
 
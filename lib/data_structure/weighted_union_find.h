@@ -0,0 +1,79 @@
+#ifndef WEIGHTED_UNION_FIND_H
+#define WEIGHTED_UNION_FIND_H
+
+#include <optional>
+#include <utility>
+#include <vector>
+#include "../concepts/algebra_concepts.h"
+
+/**
+ * 带权 (势能) 并查集, 维护形如 val(x) = w + val(y) 的约束
+ * 每个结点存到父亲的势能差 diff[x], 满足 val(x) = diff[x] + val(par[x]), 不要求 G 可交换
+ */
+template<group G>
+    requires std::equality_comparable<G>
+struct weighted_union_find {
+    // 非根结点存父亲, 根结点存 -size
+    std::vector<ptrdiff_t> par;
+    std::vector<G> diff;
+    std::vector<size_t> path;
+
+    explicit weighted_union_find(const size_t n): par(n, -1), diff(n, G::identity()) {
+    }
+
+    // 非递归的完全路径压缩, 之后 diff[n] 即 n 相对根的势能
+    size_t root(size_t n) {
+        path.clear();
+        for (; par[n] >= 0; n = par[n])
+            path.push_back(n);
+        for (size_t i = path.size(); i-- > 1;) {
+            diff[path[i - 1]] = diff[path[i - 1]] + diff[path[i]];
+            par[path[i - 1]] = static_cast<ptrdiff_t>(n);
+        }
+        return n;
+    }
+
+    size_t size(const size_t n) {
+        return -par[root(n)];
+    }
+
+    // val(n) - val(root(n))
+    G potential(const size_t n) {
+        root(n);
+        return diff[n];
+    }
+
+    /**
+     * 加入约束 val(x) = w + val(y)
+     * @return 约束与已有约束是否相容, 不相容时不做任何修改
+     */
+    bool link(const size_t x, const size_t y, const G &w) {
+        const size_t rx = root(x), ry = root(y);
+        const G px = diff[x], py = diff[y];
+        if (rx == ry)
+            return px == w + py;
+        if (par[rx] < par[ry]) {
+            par[rx] += par[ry];
+            par[ry] = static_cast<ptrdiff_t>(rx);
+            diff[ry] = -py + -w + px;
+        } else {
+            par[ry] += par[rx];
+            par[rx] = static_cast<ptrdiff_t>(ry);
+            diff[rx] = -px + w + py;
+        }
+        return true;
+    }
+
+    bool is_linked(const size_t x, const size_t y) {
+        return root(x) == root(y);
+    }
+
+    // 已连通时返回 val(x) - val(y)
+    std::optional<G> difference(const size_t x, const size_t y) {
+        if (root(x) != root(y))
+            return std::nullopt;
+        return diff[x] - diff[y];
+    }
+};
+
+#endif //WEIGHTED_UNION_FIND_H
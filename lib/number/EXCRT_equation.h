@@ -1,25 +1,32 @@
 #ifndef EXCRT_EQUATION_H
 #define EXCRT_EQUATION_H
+#include <type_traits>
+#include <vector>
 #include "exgcd.h"
 #include "utils.h"
+#include "../concepts/integral_concepts.h"
 
+// x = x (mod n), n = 0 表示无解; {0, 1} 为单位元
 template<std::signed_integral T>
 struct CRT_equation {
     T x, n;
 };
 
+// 中间乘积在两倍宽的类型中计算, 只要合并后的模数放得进 T 就不会溢出
 template<std::signed_integral T>
-CRT_equation<T> operator*(CRT_equation<T> eq1, CRT_equation<T> eq2) {
+CRT_equation<T> operator*(const CRT_equation<T> eq1, const CRT_equation<T> eq2) {
+    using W = std::conditional_t<(sizeof(T) < sizeof(long long)), long long, lll>;
     if (!eq1.n || !eq2.n)
         return {0, 0};
     T u, v;
     const T d = exgcd(eq1.n, eq2.n, u, v);
-    const T m = eq1.n / d * eq2.n;
-    const T dx = euclid_mod(eq2.x - eq1.x, m);
+    const W dx = static_cast<W>(eq2.x) - eq1.x;
     if (dx % d)
         return {0, 0};
-    u = euclid_mod(u, m) * dx / d % m;
-    return {(u * eq1.n + eq1.x) % m, m};
+    // x = eq1.x + t * eq1.n, 其中 t = u * dx / d (mod eq2.n / d)
+    const T n2 = eq2.n / d, m = eq1.n / d * eq2.n;
+    const T t = static_cast<T>(euclid_mod<W>(dx / d % n2 * u, n2));
+    return {static_cast<T>(euclid_mod<W>(eq1.x + static_cast<W>(t) * eq1.n, m)), m};
 }
 
 template<std::signed_integral T>
@@ -27,4 +34,15 @@ CRT_equation<T> &operator*=(CRT_equation<T> &eq1, CRT_equation<T> eq2) {
     return eq1 = eq1 * eq2;
 }
 
-#endif //EXCRT_EQUATION_H
\ No newline at end of file
+// 按平衡二叉树两两合并一批方程, 中间模数比从左到右依次合并时小, 总代价更低
+template<std::signed_integral T>
+CRT_equation<T> CRT_fold(std::vector<CRT_equation<T> > eqs) {
+    if (eqs.empty())
+        return {0, 1};
+    for (size_t step = 1; step < eqs.size(); step <<= 1)
+        for (size_t i = 0; i + step < eqs.size(); i += 2 * step)
+            eqs[i] *= eqs[i + step];
+    return eqs.front();
+}
+
+#endif //EXCRT_EQUATION_H
@@ -0,0 +1,147 @@
+#ifndef COMBINATORICS_H
+#define COMBINATORICS_H
+#include <span>
+#include <vector>
+#include "../math.h"
+#include "../mod_int.h"
+#include "../NTT.h"
+
+/**
+ * [0, n] 内的阶乘, 阶乘逆元与逆元, O(n) 预处理, 只做一次 qpow; 要求 n < MOD 且 MOD 为素数
+ */
+template<std::unsigned_integral T, T MOD>
+struct combinatorics {
+    using M = mod_int<T, MOD>;
+    std::vector<M> fact, inv_fact, inv;
+
+    explicit combinatorics(const size_t n) : fact(n + 1), inv_fact(n + 1), inv(n + 1) {
+        fact[0] = 1;
+        for (size_t i = 1; i <= n; ++i)
+            fact[i] = fact[i - 1] * static_cast<T>(i);
+        inv_fact[n] = fact[n].inv();
+        for (size_t i = n; i; --i) {
+            inv_fact[i - 1] = inv_fact[i] * static_cast<T>(i);
+            inv[i] = inv_fact[i] * fact[i - 1];
+        }
+    }
+
+    [[nodiscard]] M C(const size_t n, const size_t k) const {
+        return k > n ? M{} : fact[n] * inv_fact[k] * inv_fact[n - k];
+    }
+
+    [[nodiscard]] M A(const size_t n, const size_t k) const {
+        return k > n ? M{} : fact[n] * inv_fact[n - k];
+    }
+};
+
+// Montgomery 批量求逆: 原地把每个元素换成其逆元, 只做一次 qpow; 有 0 时与 inv() 一样抛异常
+template<std::unsigned_integral T, T MOD>
+void batch_inverse(const std::span<mod_int<T, MOD> > a) {
+    if (a.empty())
+        return;
+    std::vector<mod_int<T, MOD> > prefix(a.size());
+    prefix[0] = a[0];
+    for (size_t i = 1; i < a.size(); ++i)
+        prefix[i] = prefix[i - 1] * a[i];
+    mod_int<T, MOD> acc = prefix.back().inv();
+    for (size_t i = a.size() - 1; i; --i) {
+        const mod_int<T, MOD> cur = a[i];
+        a[i] = acc * prefix[i - 1];
+        acc *= cur;
+    }
+    a[0] = acc;
+}
+
+// 已知 d 次多项式在 0, 1, ..., d 处的值, 用拉格朗日插值求其在 m, m + 1, ..., m + d 处的值, 要求 m mod MOD 不在 [-d, d] 中
+template<std::unsigned_integral T, T MOD>
+std::vector<mod_int<T, MOD> > shift_sample_points(const std::vector<mod_int<T, MOD> > &f, const mod_int<T, MOD> m,
+                                                  const combinatorics<T, MOD> &comb) {
+    using M = mod_int<T, MOD>;
+    const size_t d = f.size() - 1;
+    // f(m + k) = prod_{i=0}^{d} (m + k - i) * sum_j a_j / (m + k - j)
+    std::vector<ull> a(d + 1), b(2 * d + 1);
+    for (size_t j = 0; j <= d; ++j) {
+        const M c = f[j] * comb.inv_fact[j] * comb.inv_fact[d - j];
+        a[j] = static_cast<T>((d - j) & 1 ? -c : c);
+    }
+    std::vector<M> den(2 * d + 1);
+    for (size_t t = 0; t <= 2 * d; ++t)
+        den[t] = m - static_cast<T>(d) + static_cast<T>(t);
+    std::vector<M> prefix(2 * d + 2), inv_den = den;
+    prefix[0] = 1;
+    for (size_t t = 0; t <= 2 * d; ++t)
+        prefix[t + 1] = prefix[t] * den[t];
+    batch_inverse<T, MOD>(inv_den);
+    for (size_t t = 0; t <= 2 * d; ++t)
+        b[t] = static_cast<T>(inv_den[t]);
+
+    const std::vector<ull> c = convolution_mod(a, b, MOD);
+    std::vector<M> ans(d + 1);
+    M inv_prefix = 1; // prod_{t < k} 1 / den[t]
+    for (size_t k = 0; k <= d; ++k) {
+        ans[k] = prefix[k + d + 1] * inv_prefix * static_cast<T>(c[k + d]);
+        inv_prefix *= inv_den[k];
+    }
+    return ans;
+}
+
+/**
+ * n! mod MOD, MOD 为素数, O(sqrt(MOD) log MOD)
+ * 取 v = isqrt(n), h_d(i) = prod_{j=1}^{d} (v i + j), 则 (v^2)! = prod_{i<v} h_v(i)
+ * 由 h_d 在 0..d 处的值倍增: h_{2d}(i) = h_d(i) h_d(i + d / v), 后一项由平移采样点求出
+ * n >= MOD 时为 0; n > MOD / 2 时用威尔逊定理转为 (MOD - 1 - n)!, 保证平移时分母不为 0
+ */
+template<std::unsigned_integral T, T MOD>
+mod_int<T, MOD> fast_fact(const ull n) {
+    using M = mod_int<T, MOD>;
+    if (n >= MOD)
+        return 0;
+    if (n > MOD / 2) {
+        const M rest = fast_fact<T, MOD>(MOD - 1 - n);
+        return (MOD - 1 - n) & 1 ? rest.inv() : -rest.inv();
+    }
+    const T v = static_cast<T>(isqrt(n));
+    if (v < 64) {
+        M ans = 1;
+        for (T i = 2; i <= n; ++i)
+            ans *= i;
+        return ans;
+    }
+
+    const combinatorics<T, MOD> comb(v + 1);
+    const M inv_v = comb.inv[v];
+    std::vector<M> h{1, static_cast<T>(v + 1)}; // h_1 在 0, 1 处的值
+    for (T d = 1, bit = std::bit_floor(v) >> 1; bit; bit >>= 1) {
+        // 倍增到 2d: 先补出 h_d(d + 1 .. 2d + 1), 再乘上 h_d(i + d / v)
+        const std::vector<M> ext = shift_sample_points(h, M(d + 1), comb);
+        const M m = inv_v * d;
+        std::vector<M> shifted = shift_sample_points(h, m, comb), shifted_ext =
+                shift_sample_points(h, m + (d + 1), comb);
+        h.insert(h.end(), ext.begin(), ext.end());
+        shifted.insert(shifted.end(), shifted_ext.begin(), shifted_ext.end());
+        for (size_t i = 0; i < h.size(); ++i)
+            h[i] *= shifted[i];
+        d <<= 1;
+        h.resize(d + 1);
+
+        if (v & bit) {
+            // 加一: h_{d+1}(i) = h_d(i) (v i + d + 1), 末尾补上 h_{d+1}(d + 1)
+            for (T i = 0; i <= d; ++i)
+                h[i] *= M(v) * i + (d + 1);
+            M last = 1;
+            for (T j = 1; j <= d + 1; ++j)
+                last *= M(v) * (d + 1) + j;
+            h.push_back(last);
+            ++d;
+        }
+    }
+
+    M ans = 1;
+    for (T i = 0; i < v; ++i)
+        ans *= h[i];
+    for (ull i = static_cast<ull>(v) * v + 1; i <= n; ++i)
+        ans *= static_cast<T>(i);
+    return ans;
+}
+
+#endif //COMBINATORICS_H
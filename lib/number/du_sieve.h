@@ -0,0 +1,64 @@
+#ifndef DU_SIEVE_H
+#define DU_SIEVE_H
+#include <vector>
+#include "euler_sieve.h"
+#include "../concepts/integral_concepts.h"
+
+using ll = long long;
+using ull = unsigned long long;
+
+/**
+ * 杜教筛, 求 phi 与 mu 的前缀和
+ * [1, N] 内的前缀和由 lazy_euler_sieve 线性筛出, 更大的 n / k 处按 k 从大到小非递归地求, 结果存在下标为 k 的表里
+ * 利用 sum_{d <= v} S(v / d) = v(v + 1) / 2 (phi) 或 1 (mu); N 取 n^{2/3} 时为 O(n^{2/3}), 否则 O(n / sqrt N)
+ * phi 的前缀和在 n = 1e11 时已超过 2^64, 用 128 位整数返回
+ */
+template<size_t N = 5000000>
+struct du_sieve {
+    std::vector<ull> phi_pre;
+    std::vector<ll> mu_pre;
+
+    explicit du_sieve() : phi_pre(N + 1), mu_pre(N + 1) {
+        const auto &s = lazy_euler_sieve<int, N, true, true>();
+        for (size_t i = 1; i <= N; ++i) {
+            phi_pre[i] = phi_pre[i - 1] + s.phi[i];
+            mu_pre[i] = mu_pre[i - 1] + s.mu[i];
+        }
+    }
+
+    [[nodiscard]] ulll phi_sum(const ull n) const {
+        return solve<ulll>(n, phi_pre, [](const ull v) {
+            return static_cast<ulll>(v) * (v + 1) / 2;
+        });
+    }
+
+    [[nodiscard]] ll mu_sum(const ull n) const {
+        return solve<ll>(n, mu_pre, [](ull) {
+            return 1ll;
+        });
+    }
+
+private:
+    // g_sum(v) 为 f * 1 在 [1, v] 上的和
+    template<typename S, typename P, typename F>
+    static S solve(const ull n, const std::vector<P> &pre, F g_sum) {
+        if (n <= N)
+            return pre[n];
+        // n / k > N 当且仅当 k <= K; 此时 (n / k) / d = n / (k * d), 所以大于 N 的值都已存在 big 中
+        const ull K = n / (N + 1);
+        std::vector<S> big(K + 1);
+        for (ull k = K; k; --k) {
+            const ull v = n / k;
+            S s = g_sum(v);
+            for (ull d = 2, e; d <= v; d = e + 1) {
+                const ull q = v / d;
+                e = v / q;
+                s -= static_cast<S>(e - d + 1) * (q <= N ? static_cast<S>(pre[q]) : big[k * d]);
+            }
+            big[k] = s;
+        }
+        return big[1];
+    }
+};
+
+#endif //DU_SIEVE_H
@@ -1,15 +1,16 @@
 #ifndef EULER_SIEVE_H
 #define EULER_SIEVE_H
 #include <array>
+#include <type_traits>
 #include <vector>
 #include <variant>
 
 template<typename T, size_t N, bool enable_phi = false, bool enable_mu = false>
 struct euler_sieve {
-    std::array<T, N + 1> least_factor;
+    std::array<T, N + 1> least_factor{};
     std::vector<T> primes;
-    [[no_unique_address]] std::conditional_t<enable_phi, std::array<T, N + 1>, std::monostate> phi;
-    [[no_unique_address]] std::conditional_t<enable_mu, std::array<T, N + 1>, std::monostate> mu;
+    [[no_unique_address]] std::conditional_t<enable_phi, std::array<T, N + 1>, std::monostate> phi{};
+    [[no_unique_address]] std::conditional_t<enable_mu, std::array<T, N + 1>, std::monostate> mu{};
 
     constexpr explicit euler_sieve() {
         if constexpr (enable_phi)
@@ -45,4 +46,170 @@ struct euler_sieve {
     }
 };
 
+// multiplicative_sieve 的策略: 给出积性函数在素数幂 pk = p^k 处的值
+struct phi_policy {
+    template<typename T>
+    static constexpr T prime_power(const T p, unsigned, const T pk) {
+        return pk - pk / p;
+    }
+};
+
+struct mu_policy {
+    template<typename T>
+    static constexpr T prime_power(T, const unsigned k, T) {
+        return k == 1 ? -1 : 0;
+    }
+};
+
+// 约数个数
+struct sigma0_policy {
+    template<typename T>
+    static constexpr T prime_power(T, const unsigned k, T) {
+        return k + 1;
+    }
+};
+
+// 约数和, sigma(p^k) = p^k + (p^k - 1) / (p - 1), 不先算 p^(k+1), 只要 sigma 本身不溢出 T 就正确
+struct sigma1_policy {
+    template<typename T>
+    static constexpr T prime_power(const T p, unsigned, const T pk) {
+        return pk + (pk - 1) / (p - 1);
+    }
+};
+
+/**
+ * 线性筛任意积性函数, 每个函数由一个策略类 F 给出 F::prime_power(p, k, p^k)
+ * 筛的同时记录最小素因子的幂次部分 lp_power 与指数 lp_exp, i = lp_power[i] * m 时 f(i) = f(lp_power[i]) * f(m)
+ * 只为 Fs 中的函数各开一个数组, 用 get<F>() 取出
+ */
+template<typename T, size_t N, typename... Fs>
+struct multiplicative_sieve {
+    std::array<T, N + 1> least_factor{}, lp_power{};
+    std::array<unsigned char, N + 1> lp_exp{};
+    std::vector<T> primes;
+    std::array<std::array<T, N + 1>, sizeof...(Fs)> values{};
+
+    // F 在 Fs 中的下标, 不存在时为 sizeof...(Fs)
+    template<typename F>
+    static constexpr size_t index_of() {
+        size_t i = 0;
+        (void) ((!std::is_same_v<F, Fs> && ++i) && ...);
+        return i;
+    }
+
+    template<typename F>
+        requires (index_of<F>() < sizeof...(Fs))
+    [[nodiscard]] constexpr const std::array<T, N + 1> &get() const {
+        return values[index_of<F>()];
+    }
+
+    constexpr explicit multiplicative_sieve() {
+        for (auto &f: values)
+            f[1] = 1;
+        for (T i = 2; i <= N; ++i) {
+            if (!least_factor[i]) {
+                least_factor[i] = lp_power[i] = i;
+                lp_exp[i] = 1;
+                size_t j = 0;
+                ((values[j++][i] = Fs::prime_power(i, 1u, i)), ...);
+                primes.push_back(i);
+            }
+            for (const T p: primes) {
+                if (p * i > N)
+                    break;
+                const T x = p * i;
+                least_factor[x] = p;
+                if (p == least_factor[i]) {
+                    lp_power[x] = lp_power[i] * p;
+                    lp_exp[x] = lp_exp[i] + 1;
+                    const T m = i / lp_power[i];
+                    size_t j = 0;
+                    if (m == 1)
+                        ((values[j++][x] = Fs::prime_power(p, lp_exp[x], lp_power[x])), ...);
+                    else
+                        for (auto &f: values)
+                            f[x] = f[lp_power[x]] * f[m];
+                    break;
+                }
+                lp_power[x] = p;
+                lp_exp[x] = 1;
+                for (auto &f: values)
+                    f[x] = f[i] * f[p];
+            }
+        }
+    }
+};
+
+// [2, N] 内的素数个数, 编译期用埃氏筛求, 只为确定 static_euler_sieve::primes 的长度
+template<size_t N>
+consteval size_t count_primes_upto() {
+    std::array<bool, N + 1> composite{};
+    size_t cnt = 0;
+    bool *const c = composite.data();
+    for (size_t i = 2; i <= N; ++i) {
+        if (c[i])
+            continue;
+        ++cnt;
+        for (size_t j = i * i; j <= N; j += i)
+            c[j] = true;
+    }
+    return cnt;
+}
+
+/**
+ * 编译期生成的筛表, 只用定长数组, 可以作为 constexpr 变量放进只读段, 运行时零开销
+ * primes 的长度恰为 [2, N] 内的素数个数; 受编译器常量求值步数限制, 只允许 N <= 1e5
+ */
+template<typename T, size_t N, bool enable_phi = false, bool enable_mu = false>
+    requires (N <= 100000)
+struct static_euler_sieve {
+    static constexpr size_t prime_count = count_primes_upto<N>();
+
+    std::array<T, N + 1> least_factor{};
+    std::array<T, prime_count> primes{};
+    [[no_unique_address]] std::conditional_t<enable_phi, std::array<T, N + 1>, std::monostate> phi{};
+    [[no_unique_address]] std::conditional_t<enable_mu, std::array<T, N + 1>, std::monostate> mu{};
+
+    // 常量求值按操作计步, 所以筛时只求 least_factor, phi 与 mu 再由 i / least_factor[i] 一遍递推
+    consteval explicit static_euler_sieve() {
+        T *const lf = least_factor.data(), *const pr = primes.data();
+        size_t cnt = 0;
+        for (size_t i = 2; i <= N; ++i) {
+            if (!lf[i])
+                lf[i] = pr[cnt++] = i;
+            for (size_t j = 0; j < cnt && pr[j] <= lf[i] && pr[j] * i <= N; ++j)
+                lf[pr[j] * i] = pr[j];
+        }
+
+        if constexpr (enable_phi) {
+            T *const f = phi.data();
+            f[1] = 1;
+            for (size_t i = 2; i <= N; ++i) {
+                const T p = lf[i];
+                const size_t m = i / p;
+                f[i] = lf[m] == p ? f[m] * p : f[m] * (p - 1);
+            }
+        }
+        if constexpr (enable_mu) {
+            T *const f = mu.data();
+            f[1] = 1;
+            for (size_t i = 2; i <= N; ++i) {
+                const T p = lf[i];
+                const size_t m = i / p;
+                f[i] = lf[m] == p ? 0 : -f[m];
+            }
+        }
+    }
+};
+
+template<typename T, size_t N, bool enable_phi = false, bool enable_mu = false>
+constexpr static_euler_sieve<T, N, enable_phi, enable_mu> static_euler_sieve_v{};
+
+// N 较大时在第一次调用时才筛 (线程安全), 程序启动不再为用不到的表付出代价
+template<typename T, size_t N, bool enable_phi = false, bool enable_mu = false>
+const euler_sieve<T, N, enable_phi, enable_mu> &lazy_euler_sieve() {
+    static const euler_sieve<T, N, enable_phi, enable_mu> s;
+    return s;
+}
+
 #endif //EULER_SIEVE_H
@@ -1,17 +1,20 @@
 #ifndef EXGCD_H
 #define EXGCD_H
 #include <concepts>
+#include <utility>
 
+// 非递归, 每步只做一次除法 (余数由商算出)
 template<std::signed_integral T>
-T exgcd(const T a, const T b, T &u, T &v) {
-    if (!b) {
-        u = 1;
-        v = 0;
-        return a;
+constexpr T exgcd(T a, T b, T &u, T &v) {
+    T u0 = 1, v0 = 0, u1 = 0, v1 = 1;
+    while (b) {
+        const T q = a / b;
+        a = std::exchange(b, a - q * b);
+        u0 = std::exchange(u1, u0 - q * u1);
+        v0 = std::exchange(v1, v0 - q * v1);
     }
-
-    const T d = exgcd(b, a % b, v, u);
-    v -= a / b * u;
-    return d;
+    u = u0;
+    v = v0;
+    return a;
 }
-#endif //EXGCD_H
\ No newline at end of file
+#endif //EXGCD_H
@@ -0,0 +1,55 @@
+#ifndef MONTGOMERY_H
+#define MONTGOMERY_H
+#include "../concepts/integral_concepts.h"
+
+using ull = unsigned long long;
+
+/**
+ * 64 位 Montgomery 乘法, 模数为任意奇数, 乘法只用乘与移位, 不做除法
+ * 数 a 以 a * 2^64 mod n 的形式存储, 用 to / from 转换; mul, pow 的参数与结果都是该形式
+ */
+struct montgomery64 {
+    ull n, n_inv, r2; // n * n_inv = 1 (mod 2^64), r2 = 2^128 mod n
+
+    constexpr explicit montgomery64(const ull n) : n(n), n_inv(n), r2(-static_cast<ulll>(n) % n) {
+        for (int i = 0; i < 5; ++i)
+            n_inv *= 2 - n * n_inv;
+    }
+
+    // x * 2^-64 mod n, 要求 x < n * 2^64
+    [[nodiscard]] constexpr ull reduce(const ulll x) const {
+        const ull m = static_cast<ull>(x) * n_inv;
+        const ull t = static_cast<ulll>(m) * n >> 64, hi = x >> 64;
+        return hi >= t ? hi - t : hi - t + n;
+    }
+
+    [[nodiscard]] constexpr ull to(const ull a) const {
+        return reduce(static_cast<ulll>(a % n) * r2);
+    }
+
+    [[nodiscard]] constexpr ull from(const ull a) const {
+        return reduce(a);
+    }
+
+    [[nodiscard]] constexpr ull one() const {
+        return to(1);
+    }
+
+    [[nodiscard]] constexpr ull mul(const ull a, const ull b) const {
+        return reduce(static_cast<ulll>(a) * b);
+    }
+
+    [[nodiscard]] constexpr ull add(const ull a, const ull b) const {
+        return a >= n - b ? a - (n - b) : a + b;
+    }
+
+    [[nodiscard]] constexpr ull pow(ull a, ull e) const {
+        ull ans = one();
+        for (; e; e >>= 1, a = mul(a, a))
+            if (e & 1)
+                ans = mul(ans, a);
+        return ans;
+    }
+};
+
+#endif //MONTGOMERY_H
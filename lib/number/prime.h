@@ -1,8 +1,13 @@
 #ifndef PRIME_H
 #define PRIME_H
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 #include <ranges>
+#include "montgomery.h"
 
 using ull = unsigned long long;
 
@@ -32,6 +37,101 @@ void get_factors(T n, It it) {
         *it++ = n;
 }
 
+// 64 位内确定性的 Miller-Rabin, 底数取 {2, 325, 9375, 28178, 450775, 9780504, 1795265022}
+template<std::unsigned_integral T>
+    requires (sizeof(T) <= sizeof(ull))
+constexpr bool is_prime(const T x) {
+    const ull n = x;
+    if (n < 64)
+        return 0x28208a20a08a28acull >> n & 1;
+    for (const ull p: {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61})
+        if (n % p == 0)
+            return false;
+
+    const montgomery64 mg(n);
+    const int s = std::countr_zero(n - 1);
+    const ull d = (n - 1) >> s, one = mg.one(), minus_one = n - one;
+    for (const ull base: {2ull, 325ull, 9375ull, 28178ull, 450775ull, 9780504ull, 1795265022ull}) {
+        if (base % n == 0)
+            continue;
+        ull y = mg.pow(mg.to(base), d);
+        if (y == one || y == minus_one)
+            continue;
+        for (int i = 1; i < s && y != minus_one; ++i)
+            y = mg.mul(y, y);
+        if (y != minus_one)
+            return false;
+    }
+    return true;
+}
+
+// Brent 版 Pollard-rho, n 为奇合数, 返回 n 的一个非平凡因子; 每 128 步才做一次 gcd
+inline ull pollard_rho(const ull n) {
+    constexpr size_t M = 128;
+    const montgomery64 mg(n);
+    for (ull c = 1;; ++c) {
+        const auto f = [&](const ull v) {
+            return mg.add(mg.mul(v, v), c);
+        };
+        ull x = 0, y = c, ys = 0, q = mg.one(), g = 1;
+        for (size_t r = 1; g == 1; r <<= 1) {
+            x = y;
+            for (size_t i = 0; i < r; ++i)
+                y = f(y);
+            for (size_t k = 0; k < r && g == 1; k += M) {
+                ys = y;
+                for (size_t i = 0; i < std::min(M, r - k); ++i) {
+                    y = f(y);
+                    q = mg.mul(q, x > y ? x - y : y - x);
+                }
+                g = std::gcd(q, n);
+            }
+        }
+        if (g == n) {
+            do {
+                ys = f(ys);
+                g = std::gcd(x > ys ? x - ys : ys - x, n);
+            } while (g == 1);
+        }
+        if (g != n)
+            return g;
+    }
+}
+
+// 与 get_factors 相同, 按从小到大输出 n 的所有素因子 (含重数); 小因子试除, 其余用 Pollard-rho
+template<std::unsigned_integral T, std::output_iterator<T> It>
+    requires (sizeof(T) <= sizeof(ull))
+void factorize(const T x, It it) {
+    if (!x)
+        throw std::invalid_argument{""};
+
+    std::vector<ull> factors, stack;
+    ull n = x;
+    for (ull p = 2; p < 64 && p * p <= n; p += 1 + (p > 2)) {
+        while (n % p == 0) {
+            factors.push_back(p);
+            n /= p;
+        }
+    }
+    if (n != 1)
+        stack.push_back(n);
+    while (!stack.empty()) {
+        const ull m = stack.back();
+        stack.pop_back();
+        if (m < 64 * 64 || is_prime(m)) {
+            factors.push_back(m);
+            continue;
+        }
+        const ull d = pollard_rho(m);
+        stack.push_back(d);
+        stack.push_back(m / d);
+    }
+
+    std::ranges::sort(factors);
+    for (const ull p: factors)
+        *it++ = static_cast<T>(p);
+}
+
 struct empty_dummy {
 };
 
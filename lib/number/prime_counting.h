@@ -0,0 +1,46 @@
+#ifndef PRIME_COUNTING_H
+#define PRIME_COUNTING_H
+#include <vector>
+#include "../math.h"
+
+using ull = unsigned long long;
+
+/**
+ * Lucy_Hedgehog 算法, O(n^{3/4} / log n) 时间, O(sqrt n) 空间
+ * 求出所有形如 n / k 的 v 处的 π(v), 即 [2, v] 内的素数个数
+ * small[v] 存 v <= sqrt n 处的值, large[k] 存 n / k 处的值
+ */
+struct prime_counting {
+    ull n, r;
+    std::vector<ull> small, large;
+
+    explicit prime_counting(const ull n) : n(n), r(isqrt(n)), small(r + 1), large(r + 1) {
+        for (ull v = 1; v <= r; ++v) {
+            small[v] = v - 1;
+            large[v] = n / v - 1;
+        }
+        // 每轮筛去最小素因子为 p 的合数, pc 为小于 p 的素数个数
+        for (ull p = 2; p <= r; ++p) {
+            if (small[p] == small[p - 1])
+                continue;
+            const ull pc = small[p - 1], q = p * p, end = std::min(r, n / q);
+            for (ull k = 1; k <= end; ++k) {
+                const ull d = k * p;
+                large[k] -= (d <= r ? large[d] : small[n / d]) - pc;
+            }
+            for (ull v = r; v >= q; --v)
+                small[v] -= small[v / p] - pc;
+        }
+    }
+
+    // v 必须形如 n / k
+    [[nodiscard]] ull operator()(const ull v) const {
+        return v <= r ? small[v] : large[n / v];
+    }
+};
+
+inline ull prime_pi(const ull n) {
+    return prime_counting(n)(n);
+}
+
+#endif //PRIME_COUNTING_H
@@ -0,0 +1,157 @@
+#ifndef SEGMENTED_SIEVE_H
+#define SEGMENTED_SIEVE_H
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include "../math.h"
+#include "../parallel.h"
+
+using ull = unsigned long long;
+
+/**
+ * 分段, 只存奇数, 按位压缩的埃氏筛, 筛出 [2, limit] 内的素数
+ * 奇数 2m + 1 对应第 m 位, 每块 block_bits 位 (默认 32KB, 放得进 L1), 内存只有一块加上 sqrt(limit) 以内的素数
+ * 可用 range-for 顺序枚举所有素数, count 可按块多线程并行
+ */
+struct segmented_sieve {
+    ull limit;
+    size_t block_bits;
+    ull odd_count; // [0, limit] 内的奇数个数
+    std::vector<ull> base_primes; // sqrt(limit) 以内的奇素数
+
+    explicit segmented_sieve(const ull limit, const size_t block_bytes = 32uz << 10)
+        : limit(limit), block_bits(std::max(block_bytes, 8uz) / 8 * 64), odd_count((limit + 1) / 2) {
+        const ull root = isqrt(limit);
+        std::vector<bool> composite(root + 1);
+        for (ull i = 3; i <= root; i += 2) {
+            if (composite[i])
+                continue;
+            base_primes.push_back(i);
+            for (ull j = i * i; j <= root; j += 2 * i)
+                composite[j] = true;
+        }
+    }
+
+    [[nodiscard]] size_t block_count() const {
+        return (odd_count + block_bits - 1) / block_bits;
+    }
+
+    // 顺序筛一段连续的块, 跨块时沿用每个素数的下一个倍数, 只在起点做一次除法
+    struct block_cursor {
+        const segmented_sieve *s;
+        size_t block;
+        std::vector<ull> next; // 每个素数下一个待筛去的倍数的位编号
+        std::vector<ull> bits;
+
+        block_cursor(const segmented_sieve *s, const size_t block)
+            : s(s), block(block), next(s->base_primes.size()), bits(s->block_bits / 64) {
+            const ull lo = 2 * (block * s->block_bits) + 1;
+            for (size_t i = 0; i < next.size(); ++i) {
+                const ull p = s->base_primes[i];
+                ull start = std::max(p * p, (lo + p - 1) / p * p);
+                if (!(start & 1))
+                    start += p;
+                next[i] = start / 2;
+            }
+        }
+
+        // 筛当前块到 bits (素数对应位为 1), 之后 block 前进一块
+        void sieve() {
+            const ull lo = block * s->block_bits;
+            const ull len = std::min<ull>(s->block_bits, s->odd_count - lo);
+            std::fill(bits.begin(), bits.end(), ~0ull);
+            if (len % 64)
+                bits[len / 64] = (1ull << len % 64) - 1;
+            std::fill(bits.begin() + (len + 63) / 64, bits.end(), 0ull);
+            if (!lo)
+                bits[0] &= ~1ull; // 1 不是素数
+
+            const ull hi = lo + len;
+            for (size_t i = 0; i < next.size(); ++i) {
+                const ull p = s->base_primes[i];
+                ull j = next[i];
+                for (; j < hi; j += p)
+                    bits[(j - lo) / 64] &= ~(1ull << (j - lo) % 64);
+                next[i] = j;
+            }
+            ++block;
+        }
+    };
+
+    class iterator {
+        block_cursor cursor;
+        size_t pos; // 当前素数在块内的位编号, ~0uz 表示当前值为 2 (此时 pos + 1 恰为 0)
+        bool finished;
+
+        void seek(size_t from) {
+            while (true) {
+                for (size_t w = from / 64; w < cursor.bits.size(); ++w) {
+                    const ull word = from / 64 == w ? cursor.bits[w] >> from % 64 << from % 64 : cursor.bits[w];
+                    if (word) {
+                        pos = w * 64 + (size_t) std::countr_zero(word);
+                        return;
+                    }
+                }
+                if (cursor.block >= cursor.s->block_count()) {
+                    finished = true;
+                    return;
+                }
+                cursor.sieve();
+                from = 0;
+            }
+        }
+
+    public:
+        using value_type = ull;
+        using difference_type = ptrdiff_t;
+
+        explicit iterator(const segmented_sieve *s) : cursor(s, 0), pos(~0uz), finished(s->limit < 2) {
+            if (!finished && s->block_count())
+                cursor.sieve();
+        }
+
+        ull operator*() const {
+            return ~pos ? 2 * ((cursor.block - 1) * cursor.s->block_bits + pos) + 1 : 2;
+        }
+
+        iterator &operator++() {
+            seek(pos + 1);
+            return *this;
+        }
+
+        void operator++(int) {
+            ++*this;
+        }
+
+        bool operator==(std::default_sentinel_t) const {
+            return finished;
+        }
+    };
+
+    [[nodiscard]] iterator begin() const {
+        return iterator{this};
+    }
+
+    [[nodiscard]] std::default_sentinel_t end() const {
+        return std::default_sentinel;
+    }
+
+    // [2, limit] 内的素数个数, 各线程分别负责一段连续的块
+    [[nodiscard]] ull count(const size_t threads = 1) const {
+        std::atomic<ull> ans = limit >= 2;
+        parallel_for(0uz, block_count(), threads, [&](const size_t b, const size_t e) {
+            ull local = 0;
+            for (block_cursor cursor(this, b); cursor.block < e;) {
+                cursor.sieve();
+                for (const ull word: cursor.bits)
+                    local += std::popcount(word);
+            }
+            ans += local;
+        }, 1);
+        return ans;
+    }
+};
+
+#endif //SEGMENTED_SIEVE_H
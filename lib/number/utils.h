@@ -1,11 +1,11 @@
 #ifndef UTILS_H
 #define UTILS_H
-#include <concepts>
-#include <cmath>
+#include "../concepts/integral_concepts.h"
 
-template<std::signed_integral T>
+template<generalized_signed_integral T>
 constexpr T euclid_mod(const T a, const T b) {
-    return (a % b + std::abs(b)) % b;
+    const T r = a % b;
+    return r < 0 ? r + (b < 0 ? -b : b) : r;
 }
 
-#endif //UTILS_H
\ No newline at end of file
+#endif //UTILS_H
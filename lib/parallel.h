@@ -0,0 +1,40 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+constexpr static struct parallel_t {
+} parallel_tag;
+
+inline size_t default_thread_count() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * 把 [b, e) 切成至多 threads 段并行执行 f(l, r), 返回时所有段均已完成
+ * 每段至少 grain 个元素, 不足时退化为在当前线程直接执行
+ */
+template<typename F>
+    requires requires(F f, size_t l, size_t r)
+    {
+        f(l, r);
+    }
+void parallel_for(const size_t b, const size_t e, const size_t threads, F f, const size_t grain = 1uz << 15) {
+    if (b >= e)
+        return;
+    const size_t len = e - b;
+    const size_t parts = std::min(threads, std::max(len / std::max(grain, 1uz), 1uz));
+    if (parts <= 1) {
+        f(b, e);
+        return;
+    }
+
+    std::vector<std::jthread> workers;
+    workers.reserve(parts - 1);
+    for (size_t i = 1; i < parts; ++i)
+        workers.emplace_back(f, b + len * i / parts, b + len * (i + 1) / parts);
+    f(b, b + len / parts);
+}
+
+#endif //PARALLEL_H
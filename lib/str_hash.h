@@ -1,7 +1,9 @@
 #ifndef STR_HASH_H
 #define STR_HASH_H
 
+#include <mutex>
 #include "mod_int.h"
+#include "parallel.h"
 #define ull unsigned long long
 
 // 默认小端序
@@ -11,30 +13,73 @@ class str_hash {
     std::string str;
     mod_t val;
 
+    // 第 idx 个 4 字节块, 逐字节按无符号小端拼出: 与 memcpy 后按小端解释等价, 不依赖对齐与平台字节序, 也可常量求值
+    [[nodiscard]] constexpr ull dword(const size_t idx) const {
+        const char *const p = str.data() + idx * 4;
+        return static_cast<ull>(static_cast<unsigned char>(p[0])) |
+               static_cast<ull>(static_cast<unsigned char>(p[1])) << 8 |
+               static_cast<ull>(static_cast<unsigned char>(p[2])) << 16 |
+               static_cast<ull>(static_cast<unsigned char>(p[3])) << 24;
+    }
+
+    // sum_{k in [l, r)} dword(k) * BASE^(k - l)
+    // 按下标模 4 分成 4 路, 每路以 BASE^4 为底独立做 Horner, 打断乘法取模的依赖链
+    [[nodiscard]] constexpr mod_t hash_range(const size_t l, const size_t r) const {
+        constexpr size_t lanes = 4;
+        const size_t groups = (r - l) / lanes, mid = l + groups * lanes;
+        const mod_t step = qpow(mod_t{BASE}, static_cast<ull>(lanes));
+
+        mod_t rest = 0;
+        for (size_t k = r; k > mid; --k)
+            (rest *= BASE) += dword(k - 1);
+
+        mod_t acc[lanes]{};
+        for (size_t k = mid; k > l; k -= lanes)
+            for (size_t j = 0; j < lanes; ++j)
+                (acc[j] *= step) += dword(k - lanes + j);
+
+        mod_t ans = 0;
+        for (size_t j = lanes; j--;)
+            (ans *= BASE) += acc[j];
+        return ans + rest * qpow(step, static_cast<ull>(groups));
+    }
+
+    // 不足 4 字节的尾部, 作为第 str.size() / 4 块
+    [[nodiscard]] constexpr mod_t tail() const {
+        ull t = 0;
+        for (size_t i = str.size(); i-- > str.size() / 4 * 4;)
+            (t <<= 8) |= static_cast<unsigned char>(str[i]);
+        return t;
+    }
+
 public:
     [[nodiscard]] constexpr const std::string &get_str() const { return str; };
     [[nodiscard]] constexpr ull get_val() const { return val.data; }
 
     constexpr explicit str_hash(std::string s): str(std::move(s)) {
-        const char *const raw = str.data();
-        const char *const end_ptr = raw + str.size();
-        const char *const aligned_end = raw + str.size() / 4 * 4;
-
-        val = 0;
-        for (const char *p = end_ptr - 1; p >= aligned_end; --p)
-            (val.data <<= 8) |= *p;
+        const size_t dwords = str.size() / 4;
+        val = hash_range(0, dwords) + tail() * qpow(mod_t{BASE}, static_cast<ull>(dwords));
+    }
 
-        for (const char *p = aligned_end - 4; p >= raw; p -= 4)
-            (val *= BASE) += static_cast<ull>(*reinterpret_cast<const unsigned *>(p));
+    // 按块切成若干段并行求 hash_range, 各段乘上 BASE^l 后合并
+    str_hash(std::string s, parallel_t, const size_t threads = default_thread_count()): str(std::move(s)) {
+        const size_t dwords = str.size() / 4;
+        val = tail() * qpow(mod_t{BASE}, static_cast<ull>(dwords));
+        std::mutex mtx;
+        parallel_for(0, dwords, threads, [&](const size_t l, const size_t r) {
+            const mod_t part = hash_range(l, r) * qpow(mod_t{BASE}, static_cast<ull>(l));
+            std::lock_guard lock(mtx);
+            val += part;
+        }, 1uz << 18);
     }
 
     constexpr str_hash &modify(const size_t idx, const char c) {
         const size_t dword_bias = idx % 4 * 8;
         const size_t dword_idx = idx / 4;
 
-        mod_t delta = MOD + c - str[idx];
+        mod_t delta = MOD + static_cast<unsigned char>(c) - static_cast<unsigned char>(str[idx]);
         delta *= 1ull << dword_bias;
-        delta *= pow(mod_t{BASE}, dword_idx);
+        delta *= qpow(mod_t{BASE}, static_cast<ull>(dword_idx));
 
         val += delta;
 
@@ -0,0 +1,62 @@
+#ifndef PREFIX_HASH_H
+#define PREFIX_HASH_H
+#include <algorithm>
+#include <string_view>
+#include <vector>
+#include "../concepts/integral_concepts.h"
+
+using ull = unsigned long long;
+
+/**
+ * 模 2^61 - 1 的多项式前缀哈希, 取模只用移位与加法, 不做除法
+ * pre[i] 为 s[0, i) 的哈希, pw[i] = base^i; hash(l, r) 为 s[l, r) 的哈希, O(1)
+ * 比较不同串的子串时需使用相同的 base
+ */
+struct prefix_hash {
+    static constexpr ull MOD = (1ull << 61) - 1;
+    std::vector<ull> pre, pw;
+
+    static constexpr ull mul(const ull a, const ull b) {
+        const ulll c = static_cast<ulll>(a) * b;
+        const ull r = (static_cast<ull>(c) & MOD) + static_cast<ull>(c >> 61);
+        return r >= MOD ? r - MOD : r;
+    }
+
+    explicit prefix_hash(const std::string_view s, const ull base = 0x1f2e3d4c5b6a7988 % MOD)
+        : pre(s.size() + 1), pw(s.size() + 1) {
+        pw[0] = 1;
+        for (size_t i = 0; i < s.size(); ++i) {
+            pw[i + 1] = mul(pw[i], base);
+            const ull h = mul(pre[i], base) + static_cast<unsigned char>(s[i]);
+            pre[i + 1] = h >= MOD ? h - MOD : h;
+        }
+    }
+
+    [[nodiscard]] size_t size() const {
+        return pre.size() - 1;
+    }
+
+    [[nodiscard]] ull hash(const size_t l, const size_t r) const {
+        const ull sub = mul(pre[l], pw[r - l]);
+        return pre[r] >= sub ? pre[r] - sub : pre[r] + MOD - sub;
+    }
+
+    // a 从 i 开始的后缀与 b 从 j 开始的后缀的最长公共前缀, 二分, O(log n)
+    static size_t lcp(const prefix_hash &a, const size_t i, const prefix_hash &b, const size_t j) {
+        size_t lo = 0, hi = std::min(a.size() - i, b.size() - j);
+        while (lo < hi) {
+            const size_t mid = (lo + hi + 1) / 2;
+            if (a.hash(i, i + mid) == b.hash(j, j + mid))
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        return lo;
+    }
+
+    [[nodiscard]] size_t lcp(const size_t i, const size_t j) const {
+        return lcp(*this, i, *this, j);
+    }
+};
+
+#endif //PREFIX_HASH_H